@@ -0,0 +1,74 @@
+// Generated by sim/chordal from finger_model in keymap.c; do not edit.
+//
+// Entry [row][col], bit o: the tap-hold key at matrix row, col may be held
+// when the key at row * MATRIX_COLS + col = o is pressed. Bits 0-31 are in
+// the first word, 32-47 in the second.
+
+#pragma once
+
+#define CHORDAL_HOLD_MATRIX { \
+    { \
+        {0xffe030c3, 0x00001fff},  /* 0,0: LAYOUT  0, left pinky, row 0, column 0 */ \
+        {0xffe030c3, 0x00001fff},  /* 0,1: LAYOUT  1, left pinky, row 0, column 1 */ \
+        {0xffe04104, 0x00001fff},  /* 0,2: LAYOUT  2, left ring, row 0, column 2 */ \
+        {0xffe08208, 0x00001fff},  /* 0,3: LAYOUT  3, left middle, row 0, column 3 */ \
+        {0xffe30c30, 0x00001fff},  /* 0,4: LAYOUT  4, left index, row 0, column 4 */ \
+        {0xffe30c30, 0x00001fff},  /* 0,5: LAYOUT  5, left index, row 0, column 5 */ \
+    }, \
+    { \
+        {0xffe030c3, 0x00001fff},  /* 1,0: LAYOUT 12, left pinky, row 1, column 0 */ \
+        {0xffe030c3, 0x00001fff},  /* 1,1: LAYOUT 13, left pinky, row 1, column 1 */ \
+        {0xffe04104, 0x00001fff},  /* 1,2: LAYOUT 14, left ring, row 1, column 2 */ \
+        {0xffe08208, 0x00001fff},  /* 1,3: LAYOUT 15, left middle, row 1, column 3 */ \
+        {0xffe30c30, 0x00001fff},  /* 1,4: LAYOUT 16, left index, row 1, column 4 */ \
+        {0xffe30c30, 0x00001fff},  /* 1,5: LAYOUT 17, left index, row 1, column 5 */ \
+    }, \
+    { \
+        {0xffe030c3, 0x00001fff},  /* 2,0: LAYOUT 24, left pinky, row 2, column 0 */ \
+        {0xffe030c3, 0x00001fff},  /* 2,1: LAYOUT 25, left pinky, row 2, column 1 */ \
+        {0xffe04104, 0x00001fff},  /* 2,2: LAYOUT 26, left ring, row 2, column 2 */ \
+        {0xffe08208, 0x00001fff},  /* 2,3: LAYOUT 27, left middle, row 2, column 3 */ \
+        {0xffe30c30, 0x00001fff},  /* 2,4: LAYOUT 28, left index, row 2, column 4 */ \
+        {0xffe30c30, 0x00001fff},  /* 2,5: LAYOUT 29, left index, row 2, column 5 */ \
+    }, \
+    { \
+        {0x00000000, 0x00000000},  /* 3,0: no key */ \
+        {0x00000000, 0x00000000},  /* 3,1: no key */ \
+        {0x00000000, 0x00000000},  /* 3,2: no key */ \
+        {0xffe3ffff, 0x00001fff},  /* 3,3: LAYOUT 36, left thumb, row 3, column 3 */ \
+        {0xffe3ffff, 0x00001fff},  /* 3,4: LAYOUT 37, left thumb, row 3, column 4 */ \
+        {0xffe3ffff, 0x00001fff},  /* 3,5: LAYOUT 38, left thumb, row 3, column 5 */ \
+    }, \
+    { \
+        {0xc3e3ffff, 0x00001c30},  /* 4,0: LAYOUT  6, right index, row 0, column 6 */ \
+        {0xc3e3ffff, 0x00001c30},  /* 4,1: LAYOUT  7, right index, row 0, column 7 */ \
+        {0x04e3ffff, 0x00001c41},  /* 4,2: LAYOUT  8, right middle, row 0, column 8 */ \
+        {0x08e3ffff, 0x00001c82},  /* 4,3: LAYOUT  9, right ring, row 0, column 9 */ \
+        {0x30e3ffff, 0x00001f0c},  /* 4,4: LAYOUT 10, right pinky, row 0, column 10 */ \
+        {0x30e3ffff, 0x00001f0c},  /* 4,5: LAYOUT 11, right pinky, row 0, column 11 */ \
+    }, \
+    { \
+        {0xc3e3ffff, 0x00001c30},  /* 5,0: LAYOUT 18, right index, row 1, column 6 */ \
+        {0xc3e3ffff, 0x00001c30},  /* 5,1: LAYOUT 19, right index, row 1, column 7 */ \
+        {0x04e3ffff, 0x00001c41},  /* 5,2: LAYOUT 20, right middle, row 1, column 8 */ \
+        {0x08e3ffff, 0x00001c82},  /* 5,3: LAYOUT 21, right ring, row 1, column 9 */ \
+        {0x30e3ffff, 0x00001f0c},  /* 5,4: LAYOUT 22, right pinky, row 1, column 10 */ \
+        {0x30e3ffff, 0x00001f0c},  /* 5,5: LAYOUT 23, right pinky, row 1, column 11 */ \
+    }, \
+    { \
+        {0xc3e3ffff, 0x00001c30},  /* 6,0: LAYOUT 30, right index, row 2, column 6 */ \
+        {0xc3e3ffff, 0x00001c30},  /* 6,1: LAYOUT 31, right index, row 2, column 7 */ \
+        {0x04e3ffff, 0x00001c41},  /* 6,2: LAYOUT 32, right middle, row 2, column 8 */ \
+        {0x08e3ffff, 0x00001c82},  /* 6,3: LAYOUT 33, right ring, row 2, column 9 */ \
+        {0x30e3ffff, 0x00001f0c},  /* 6,4: LAYOUT 34, right pinky, row 2, column 10 */ \
+        {0x30e3ffff, 0x00001f0c},  /* 6,5: LAYOUT 35, right pinky, row 2, column 11 */ \
+    }, \
+    { \
+        {0xffe3ffff, 0x00001fff},  /* 7,0: LAYOUT 39, right thumb, row 3, column 6 */ \
+        {0xffe3ffff, 0x00001fff},  /* 7,1: LAYOUT 40, right thumb, row 3, column 7 */ \
+        {0xffe3ffff, 0x00001fff},  /* 7,2: LAYOUT 41, right thumb, row 3, column 8 */ \
+        {0x00000000, 0x00000000},  /* 7,3: no key */ \
+        {0x00000000, 0x00000000},  /* 7,4: no key */ \
+        {0x00000000, 0x00000000},  /* 7,5: no key */ \
+    }, \
+}
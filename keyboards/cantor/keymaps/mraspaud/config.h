@@ -1,11 +1,17 @@
 #define TAPPING_TERM 250
+#define TAPPING_TERM_PER_KEY
 #define PERMISSIVE_HOLD
 #define FLOW_TAP_TERM 150
 #define CHORDAL_HOLD
 #define SPECULATIVE_HOLD
-#define UNICODE_SELECTED_MODES UNICODE_MODE_LINUX
 #define UNICODE_KEY_LNX LCTL(LSFT(KC_U))
-#define UNICODE_TYPE_DELAY 10
+#define UNICODE_TYPE_DELAY 0
 #define MAX_DEFERRED_EXECUTORS 10
 #define USB_SUSPEND_WAKEUP_DELAY 200
 #define NO_USB_STARTUP_CHECK
+// Adaptive tapping terms at 0, the bigram sketch at 64.
+#ifdef BIGRAM_ENABLE
+#    define EECONFIG_USER_DATA_SIZE (64 + 2056)
+#else
+#    define EECONFIG_USER_DATA_SIZE 64
+#endif
@@ -0,0 +1,139 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "adaptive_term.h"
+
+#include "timeouts.h"
+
+#define ADAPTIVE_TERM_VERSION 1
+
+typedef struct {
+    uint16_t mean8;  // Mean tap duration in ms, times 8.
+    uint16_t dev4;   // Mean deviation in ms, times 4.
+    uint8_t  samples;
+} estimator_t;
+
+typedef struct {
+    uint8_t     version;
+    uint8_t     checksum;
+    estimator_t keys[ADAPTIVE_TERM_MAX_KEYS];
+} saved_t;
+
+_Static_assert(sizeof(saved_t) <= ADAPTIVE_TERM_EEPROM_SIZE, "ADAPTIVE_TERM_EEPROM_SIZE too small");
+_Static_assert(EECONFIG_USER_DATA_SIZE >= ADAPTIVE_TERM_EEPROM_SIZE, "EECONFIG_USER_DATA_SIZE too small for the adaptive terms");
+
+static saved_t  state;
+static uint16_t terms[ADAPTIVE_TERM_MAX_KEYS];
+static uint16_t saved_terms[ADAPTIVE_TERM_MAX_KEYS];
+static uint16_t pressed_at[ADAPTIVE_TERM_MAX_KEYS];
+static uint8_t  interrupted = 0;  // Keys another key was pressed on since their press.
+
+static void save(void);
+static timeout_t save_delay = TIMEOUT_INIT(save);
+
+static uint8_t key_count(void) {
+    return NUM_ADAPTIVE_TERM_KEYS < ADAPTIVE_TERM_MAX_KEYS ? NUM_ADAPTIVE_TERM_KEYS : ADAPTIVE_TERM_MAX_KEYS;
+}
+
+static int8_t key_index(uint16_t keycode) {
+    for (uint8_t i = 0; i < key_count(); i++) {
+        if (pgm_read_word(&adaptive_term_keys[i]) == keycode) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static uint8_t checksum(const saved_t *saved) {
+    const uint8_t *bytes = (const uint8_t *)saved->keys;
+    uint8_t        sum   = ADAPTIVE_TERM_VERSION;
+    for (uint8_t i = 0; i < sizeof(saved->keys); i++) {
+        sum = (sum << 1 | sum >> 7) ^ bytes[i];
+    }
+    return sum;
+}
+
+static uint16_t term_of(const estimator_t *estimator) {
+    if (estimator->samples < ADAPTIVE_TERM_WARMUP) {
+        return TAPPING_TERM;
+    }
+    const uint32_t term = estimator->mean8 / 8 + (uint32_t)ADAPTIVE_TERM_DEVIATIONS * estimator->dev4 / 4;
+    return term < ADAPTIVE_TERM_MIN ? ADAPTIVE_TERM_MIN : term > ADAPTIVE_TERM_MAX ? ADAPTIVE_TERM_MAX : term;
+}
+
+static void save(void) {
+    state.version  = ADAPTIVE_TERM_VERSION;
+    state.checksum = checksum(&state);
+    eeconfig_update_user_datablock(&state, 0, sizeof(state));
+    memcpy(saved_terms, terms, sizeof(terms));
+}
+
+static void sample(uint8_t index, uint16_t duration) {
+    estimator_t *estimator = &state.keys[index];
+    if (estimator->samples == 0) {
+        estimator->mean8 = duration * 8;
+        estimator->dev4  = duration * 2;
+    } else {
+        // mean += (duration - mean) / 8, dev += (|duration - mean| - dev) / 4
+        const int16_t error = duration - estimator->mean8 / 8;
+        estimator->mean8 += error;
+        estimator->dev4 += (error < 0 ? -error : error) - estimator->dev4 / 4;
+    }
+    if (estimator->samples < UINT8_MAX) {
+        estimator->samples++;
+    }
+    terms[index] = term_of(estimator);
+
+    const int16_t drift = terms[index] - saved_terms[index];
+    if ((drift >= ADAPTIVE_TERM_SAVE_DELTA || drift <= -ADAPTIVE_TERM_SAVE_DELTA) && !timeout_pending(&save_delay)) {
+        timeout_start(&save_delay, ADAPTIVE_TERM_SAVE_INTERVAL);
+    }
+}
+
+void adaptive_term_init(void) {
+    eeconfig_read_user_datablock(&state, 0, sizeof(state));
+    if (state.version != ADAPTIVE_TERM_VERSION || state.checksum != checksum(&state)) {
+        memset(&state, 0, sizeof(state));
+    }
+    for (uint8_t i = 0; i < ADAPTIVE_TERM_MAX_KEYS; i++) {
+        terms[i] = term_of(&state.keys[i]);
+    }
+    memcpy(saved_terms, terms, sizeof(terms));
+    interrupted = 0;
+}
+
+void adaptive_term_reset(void) {
+    memset(&state, 0, sizeof(state));
+    for (uint8_t i = 0; i < ADAPTIVE_TERM_MAX_KEYS; i++) {
+        terms[i] = TAPPING_TERM;
+    }
+    save();
+}
+
+uint16_t adaptive_term_get(uint16_t keycode) {
+    const int8_t index = key_index(keycode);
+    return index >= 0 ? terms[index] : TAPPING_TERM;
+}
+
+bool process_adaptive_term(const key_event_t *event, keyrecord_t *record) {
+    const int8_t index = key_index(event->keycode);
+    if (event->pressed) {
+        interrupted = 0xFF;
+        if (index >= 0) {
+            interrupted &= ~(1 << index);
+            pressed_at[index] = record->event.time;
+        }
+        return true;
+    }
+    if (index < 0) {
+        return true;
+    }
+    const uint16_t duration = TIMER_DIFF_16(record->event.time, pressed_at[index]);
+    if (record->tap.count > 0) {
+        sample(index, duration);
+    } else if (!(interrupted & (1 << index)) && duration < ADAPTIVE_TERM_MAX) {
+        // Held alone and let go: a tap that came too slowly.
+        sample(index, duration);
+    }
+    return true;
+}
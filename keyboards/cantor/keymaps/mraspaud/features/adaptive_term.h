@@ -0,0 +1,76 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Tapping terms learned per key from how long its taps actually last.
+//
+// For every listed tap-hold key, the duration of each tap feeds a running
+// mean and mean deviation (the estimator TCP uses for retransmit timeouts:
+// two 16-bit fixed-point numbers per key), and the key's tapping term is
+// the mean plus ADAPTIVE_TERM_DEVIATIONS deviations, kept between
+// ADAPTIVE_TERM_MIN and ADAPTIVE_TERM_MAX. A press held alone past its term
+// and released without any other key in between was a slow tap, and counts
+// as one. Until a key has ADAPTIVE_TERM_WARMUP samples it keeps
+// TAPPING_TERM.
+//
+// The estimators live in the EEPROM user datablock. They are written back
+// at most once per ADAPTIVE_TERM_SAVE_INTERVAL, and only once some term has
+// moved ADAPTIVE_TERM_SAVE_DELTA away from the saved one.
+//
+// Usage in keymap.c:
+//
+//     const uint16_t adaptive_term_keys[] PROGMEM = {MT_E, MT_N, LT_R};
+//     uint8_t NUM_ADAPTIVE_TERM_KEYS = ARRAY_SIZE(adaptive_term_keys);
+//
+//     uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+//         return adaptive_term_get(keycode);
+//     }
+//
+// then call adaptive_term_init() from keyboard_post_init_user() (after
+// timeouts_init()), register process_adaptive_term() first in
+// key_handlers[] (key_event.h) for every keycode, and adaptive_term_reset() from eeconfig_init_user().
+// Needs TAPPING_TERM_PER_KEY and an EECONFIG_USER_DATA_SIZE of at least
+// ADAPTIVE_TERM_EEPROM_SIZE; the save delay runs on features/timeouts.c.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "key_event.h"
+
+#define ADAPTIVE_TERM_MAX_KEYS 8
+#define ADAPTIVE_TERM_EEPROM_SIZE (2 + 6 * ADAPTIVE_TERM_MAX_KEYS)
+
+#ifndef ADAPTIVE_TERM_MIN
+#    define ADAPTIVE_TERM_MIN 120
+#endif
+#ifndef ADAPTIVE_TERM_MAX
+#    define ADAPTIVE_TERM_MAX 300
+#endif
+#ifndef ADAPTIVE_TERM_DEVIATIONS
+#    define ADAPTIVE_TERM_DEVIATIONS 4
+#endif
+#ifndef ADAPTIVE_TERM_WARMUP
+#    define ADAPTIVE_TERM_WARMUP 16
+#endif
+#ifndef ADAPTIVE_TERM_SAVE_DELTA
+#    define ADAPTIVE_TERM_SAVE_DELTA 10
+#endif
+#ifndef ADAPTIVE_TERM_SAVE_INTERVAL
+#    define ADAPTIVE_TERM_SAVE_INTERVAL 600000  // 10 minutes
+#endif
+
+extern const uint16_t adaptive_term_keys[];
+extern uint8_t        NUM_ADAPTIVE_TERM_KEYS;
+
+// Loads the estimators from EEPROM, or starts afresh if they are not there.
+void adaptive_term_init(void);
+
+// Forgets everything learned, in RAM and in EEPROM.
+void adaptive_term_reset(void);
+
+// The learned term of `keycode`, TAPPING_TERM for keys not listed or still
+// warming up.
+uint16_t adaptive_term_get(uint16_t keycode);
+
+// Learns from the taps, and from the other keys pressed in between. Always
+// returns true.
+bool process_adaptive_term(const key_event_t *event, keyrecord_t *record);
@@ -0,0 +1,216 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "bigram.h"
+
+#ifdef RAW_ENABLE
+#    include "raw_hid.h"
+#endif
+#include "timeouts.h"
+
+#define BIGRAM_VERSION 1
+#define NO_KEY 0xFF
+
+typedef struct {
+    uint8_t  version;
+    uint8_t  checksum;
+    uint16_t reserved;
+    uint32_t total;
+    uint16_t counters[BIGRAM_ROWS][BIGRAM_WIDTH];
+} saved_t;
+
+_Static_assert(BIGRAM_WIDTH == 256, "rows are indexed by the top byte of a hash");
+_Static_assert(sizeof(saved_t) <= BIGRAM_EEPROM_SIZE, "BIGRAM_EEPROM_SIZE too small");
+_Static_assert(EECONFIG_USER_DATA_SIZE >= BIGRAM_EEPROM_OFFSET + BIGRAM_EEPROM_SIZE, "EECONFIG_USER_DATA_SIZE too small for the bigram sketch");
+
+// One odd multiplier per row; tools/bigram.py uses the same.
+static const uint32_t multipliers[BIGRAM_ROWS] = {0x9E3779B1, 0x85EBCA77, 0xC2B2AE3D, 0x27D4EB2F};
+
+static saved_t  sketch;
+static uint16_t unsaved = 0;  // Bigrams counted since the last save.
+
+static uint8_t  last_position = NO_KEY;
+static uint8_t  last_layer    = 0;
+static uint16_t last_time     = 0;
+static uint32_t last_press    = 0;  // timer_read32() of the last press, for the save pause.
+
+static void save_when_idle(void);
+static timeout_t save_delay = TIMEOUT_INIT(save_when_idle);
+
+__attribute__((weak)) uint8_t bigram_position(keypos_t key) {
+    return key.row * MATRIX_COLS + key.col;
+}
+
+static uint8_t index_of(uint16_t item, uint8_t row) {
+    return (uint32_t)(item * multipliers[row]) >> 24;
+}
+
+static uint8_t checksum(const saved_t *saved) {
+    const uint8_t *bytes = (const uint8_t *)&saved->total;
+    const uint16_t size  = sizeof(saved_t) - offsetof(saved_t, total);
+    uint8_t        sum   = BIGRAM_VERSION;
+    for (uint16_t i = 0; i < size; i++) {
+        sum = (sum << 1 | sum >> 7) ^ bytes[i];
+    }
+    return sum;
+}
+
+static void save(void) {
+    sketch.version  = BIGRAM_VERSION;
+    sketch.checksum = checksum(&sketch);
+    eeconfig_update_user_datablock(&sketch, BIGRAM_EEPROM_OFFSET, sizeof(sketch));
+    unsaved = 0;
+}
+
+// EEPROM writes stall the scan, so they wait for a pause in the typing.
+static void save_when_idle(void) {
+    const uint32_t idle = timer_elapsed32(last_press);
+    if (idle < BIGRAM_SAVE_IDLE) {
+        timeout_start(&save_delay, BIGRAM_SAVE_IDLE - idle);
+        return;
+    }
+    save();
+}
+
+static void halve(void) {
+    for (uint8_t row = 0; row < BIGRAM_ROWS; row++) {
+        for (uint16_t i = 0; i < BIGRAM_WIDTH; i++) {
+            sketch.counters[row][i] >>= 1;
+        }
+    }
+    sketch.total >>= 1;
+}
+
+static void add(uint16_t item) {
+    uint16_t *counters[BIGRAM_ROWS];
+    uint16_t  count = UINT16_MAX;
+    for (uint8_t row = 0; row < BIGRAM_ROWS; row++) {
+        counters[row] = &sketch.counters[row][index_of(item, row)];
+        if (*counters[row] < count) {
+            count = *counters[row];
+        }
+    }
+    if (count == UINT16_MAX) {
+        halve();
+        count >>= 1;
+    }
+    count++;
+    for (uint8_t row = 0; row < BIGRAM_ROWS; row++) {
+        if (*counters[row] < count) {
+            *counters[row] = count;
+        }
+    }
+    sketch.total++;
+    if (++unsaved >= BIGRAM_SAVE_MIN && !timeout_pending(&save_delay)) {
+        timeout_start(&save_delay, BIGRAM_SAVE_INTERVAL);
+    }
+}
+
+static bool counted(uint8_t layer) {
+    return bigram_layers & ((layer_state_t)1 << layer);
+}
+
+void bigram_record(keyrecord_t *record) {
+    if (record->event.type != KEY_EVENT || !record->event.pressed) {
+        return;
+    }
+    const uint8_t position = bigram_position(record->event.key) & 0x3F;
+    const uint8_t layer    = get_highest_layer(layer_state | default_layer_state);
+    const bool    typing   = last_position != NO_KEY && TIMER_DIFF_16(record->event.time, last_time) < BIGRAM_IDLE;
+    if (typing && position != BIGRAM_LAYER_CHANGE) {
+        if (layer == last_layer) {
+            if (counted(layer)) {
+                add(BIGRAM_ITEM(layer, last_position, position));
+            }
+        } else if (counted(layer) || counted(last_layer)) {
+            add(BIGRAM_ITEM(layer, BIGRAM_LAYER_CHANGE, last_layer));
+        }
+    }
+    last_position = position;
+    last_layer    = layer;
+    last_time     = record->event.time;
+    last_press    = timer_read32();
+}
+
+uint16_t bigram_estimate(uint16_t item) {
+    uint16_t count = UINT16_MAX;
+    for (uint8_t row = 0; row < BIGRAM_ROWS; row++) {
+        const uint16_t counter = sketch.counters[row][index_of(item, row)];
+        if (counter < count) {
+            count = counter;
+        }
+    }
+    return count;
+}
+
+uint32_t bigram_total(void) {
+    return sketch.total;
+}
+
+void bigram_init(void) {
+    eeconfig_read_user_datablock(&sketch, BIGRAM_EEPROM_OFFSET, sizeof(sketch));
+    if (sketch.version != BIGRAM_VERSION || sketch.checksum != checksum(&sketch)) {
+        memset(&sketch, 0, sizeof(sketch));
+    }
+    unsaved       = 0;
+    last_position = NO_KEY;
+}
+
+void bigram_reset(void) {
+    timeout_cancel(&save_delay);
+    memset(&sketch, 0, sizeof(sketch));
+    last_position = NO_KEY;
+    save();
+}
+
+#ifdef RAW_ENABLE
+static void put16(uint8_t *data, uint16_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+}
+
+static void put32(uint8_t *data, uint32_t value) {
+    put16(data, value);
+    put16(data + 2, value >> 16);
+}
+
+bool bigram_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 16 || data[0] != BIGRAM_RAW_ID) {
+        return false;
+    }
+    switch (data[1]) {
+        case BIGRAM_RAW_INFO:
+            data[2] = BIGRAM_ROWS;
+            data[3] = 8;  // log2(BIGRAM_WIDTH)
+            data[4] = BIGRAM_VERSION;
+            data[5] = data[6] = data[7] = 0;
+            put32(&data[8], sketch.total);
+            put32(&data[12], bigram_layers);
+            break;
+        case BIGRAM_RAW_READ: {
+            const uint8_t row   = data[2];
+            const uint8_t first = data[3];
+            if (row >= BIGRAM_ROWS) {
+                data[1] = 0xFF;
+                break;
+            }
+            for (uint8_t i = 0; i < (length - 4) / 2 && first + i < BIGRAM_WIDTH; i++) {
+                put16(&data[4 + 2 * i], sketch.counters[row][first + i]);
+            }
+            break;
+        }
+        case BIGRAM_RAW_SAVE:
+            timeout_cancel(&save_delay);
+            save();
+            break;
+        case BIGRAM_RAW_RESET:
+            bigram_reset();
+            break;
+        default:
+            data[1] = 0xFF;
+            break;
+    }
+    raw_hid_send(data, length);
+    return true;
+}
+#endif
@@ -0,0 +1,125 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Counts of the key bigrams and layer changes actually typed, kept on the
+// keyboard.
+//
+// Every key press on a counted layer adds the bigram (key before, this key)
+// of that layer, keys named by their position in the layout, and a press on
+// another layer than the key before it adds the layer change. Counts go to a
+// count-min sketch: BIGRAM_ROWS rows of BIGRAM_WIDTH 16-bit counters, each
+// row indexed by its own hash of the bigram, the counters of a bigram raised
+// only as far as its smallest one needs (conservative update). A bigram's
+// count is the smallest of its counters: never below the true count, and
+// rarely above it by more than a few per mille of all the bigrams counted.
+// RAM is fixed whatever is typed, 2 KB with the defaults; counting is a few
+// multiplications per press.
+//
+// When a counter would overflow, all of them are halved, so old typing
+// fades out. A press after BIGRAM_IDLE ms without typing starts afresh.
+//
+// The sketch lives in the EEPROM user datablock at BIGRAM_EEPROM_OFFSET.
+// It is written back at most once per BIGRAM_SAVE_INTERVAL, after
+// BIGRAM_SAVE_MIN new bigrams and a typing pause; only the counters that
+// changed are written, and QMK's wear-levelled EEPROM emulation spreads
+// those over the flash.
+//
+// tools/bigram.py reads the sketch over raw HID and prints the most frequent
+// bigrams of each layer, with the key labels of thornium.yaml.
+//
+// Usage in keymap.c:
+//
+//     const layer_state_t bigram_layers = LAYER_BIT(L_EN) | LAYER_BIT(L_SE);
+//
+// then call bigram_init() from keyboard_post_init_user() (after
+// timeouts_init()), bigram_record() from process_record_user(), and
+// bigram_reset() from eeconfig_init_user(). Needs an EECONFIG_USER_DATA_SIZE
+// of at least BIGRAM_EEPROM_OFFSET + BIGRAM_EEPROM_SIZE.
+//
+// Build with BIGRAM_ENABLE=yes (qmk compile -e BIGRAM_ENABLE=yes). Without
+// it the hooks are empty inline functions and nothing is compiled in.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#define BIGRAM_ROWS 4
+#define BIGRAM_WIDTH 256  // Counters per row, indexed by the top byte of a hash.
+#define BIGRAM_EEPROM_SIZE (8 + 2 * BIGRAM_ROWS * BIGRAM_WIDTH)
+
+#ifndef BIGRAM_EEPROM_OFFSET
+#    define BIGRAM_EEPROM_OFFSET 64
+#endif
+#ifndef BIGRAM_IDLE
+#    define BIGRAM_IDLE 2000
+#endif
+#ifndef BIGRAM_SAVE_INTERVAL
+#    define BIGRAM_SAVE_INTERVAL 1800000  // 30 minutes
+#endif
+#ifndef BIGRAM_SAVE_MIN
+#    define BIGRAM_SAVE_MIN 500
+#endif
+#ifndef BIGRAM_SAVE_IDLE
+#    define BIGRAM_SAVE_IDLE 5000
+#endif
+
+// A bigram of `layer`, from the key at layout position `prev` to the one at
+// `cur`. Changes to layer `to` from layer `from` are counted as the bigram
+// (BIGRAM_LAYER_CHANGE, from) of `to`.
+#define BIGRAM_ITEM(layer, prev, cur) ((uint16_t)((layer) << 12 | (prev) << 6 | (cur)))
+#define BIGRAM_LAYER_CHANGE 63
+
+// Layers whose bigrams are counted; layer changes are counted when either
+// side is one of them.
+extern const layer_state_t bigram_layers;
+
+// Raw HID requests, 32 bytes, answered in place. Byte 0 is BIGRAM_RAW_ID.
+//
+//     INFO                -> INFO, rows, log2(width), version, 0, 0, 0, total, layers (LE)
+//     READ row first      -> READ, row, first, up to 14 counters (LE)
+//     SAVE                -> SAVE, after writing the sketch to EEPROM
+//     RESET               -> RESET
+//
+// Unknown requests are answered with 0xFF in byte 1.
+#define BIGRAM_RAW_ID 'B'
+enum bigram_raw_command {
+    BIGRAM_RAW_INFO,
+    BIGRAM_RAW_READ,
+    BIGRAM_RAW_SAVE,
+    BIGRAM_RAW_RESET,
+};
+
+#ifdef BIGRAM_ENABLE
+
+void bigram_init(void);
+// Clears the counts, in RAM and in EEPROM.
+void bigram_reset(void);
+
+// Counts the press of `record` if it is one.
+void bigram_record(keyrecord_t *record);
+
+// The estimated count of `item` (a BIGRAM_ITEM), and of everything counted.
+uint16_t bigram_estimate(uint16_t item);
+uint32_t bigram_total(void);
+
+// Answers the raw HID requests tagged BIGRAM_RAW_ID; returns false on others.
+bool bigram_raw_hid_receive(uint8_t *data, uint8_t length);
+
+// Layout position of a key, 0 to 62. Defaults to row * MATRIX_COLS + col;
+// the keymap overrides it to number keys in LAYOUT order.
+uint8_t bigram_position(keypos_t key);
+
+#else
+
+static inline void bigram_init(void) {}
+static inline void bigram_reset(void) {}
+static inline void bigram_record(keyrecord_t *record) {
+    (void)record;
+}
+static inline bool bigram_raw_hid_receive(uint8_t *data, uint8_t length) {
+    (void)data;
+    (void)length;
+    return false;
+}
+
+#endif
@@ -28,7 +28,9 @@
 #error "custom_shift_keys: QMK version is too old to build. Please update QMK."
 #else
 
-bool process_custom_shift_keys(uint16_t keycode, keyrecord_t *record) {
+bool process_custom_shift_keys(const key_event_t *event, keyrecord_t *record) {
+  (void)record;
+  const uint16_t keycode = event->keycode;
   static uint16_t registered_keycode = KC_NO;
 
   // If a custom shift key is registered, then this event is either releasing
@@ -39,51 +41,40 @@ bool process_custom_shift_keys(uint16_t keycode, keyrecord_t *record) {
     registered_keycode = KC_NO;
   }
 
-  if (record->event.pressed) {  // Press event.
-    const uint8_t saved_mods = get_mods();
-#ifndef NO_ACTION_ONESHOT
-    const uint8_t mods = saved_mods | get_weak_mods() | get_oneshot_mods();
-#else
-    const uint8_t mods = saved_mods | get_weak_mods();
-#endif  // NO_ACTION_ONESHOT
-#if CUSTOM_SHIFT_KEYS_LAYER_MASK != 0
-    const uint8_t layer = read_source_layers_cache(record->event.key);
-#endif  // CUSTOM_SHIFT_KEYS_LAYER_MASK
-    if ((mods & MOD_MASK_SHIFT) != 0  // Shift is held.
+  if (event->pressed) {  // Press event.
+    if (event->shift  // Shift is held.
 #if CUSTOM_SHIFT_KEYS_NEGMODS != 0
         // Nothing in CUSTOM_SHIFT_KEYS_NEGMODS is held.
-        && (mods & (CUSTOM_SHIFT_KEYS_NEGMODS)) == 0
+        && (event->mods & (CUSTOM_SHIFT_KEYS_NEGMODS)) == 0
 #endif  // CUSTOM_SHIFT_KEYS_NEGMODS != 0
 #if CUSTOM_SHIFT_KEYS_LAYER_MASK != 0
         // Pressed key is on a layer appearing in the layer mask.
-        && ((1 << layer) & (CUSTOM_SHIFT_KEYS_LAYER_MASK)) != 0
+        && ((1 << event->layer) & (CUSTOM_SHIFT_KEYS_LAYER_MASK)) != 0
 #endif  // CUSTOM_SHIFT_KEYS_LAYER_MASK
           ) {
       // Continue default handling if this is a tap-hold key being held.
-      if ((IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) &&
-          record->tap.count == 0) {
+      if (event->tap_keycode == KC_NO) {
         return true;
       }
 
-      // Search for a custom shift key whose keycode is `keycode`.
-      for (int i = 0; i < NUM_CUSTOM_SHIFT_KEYS; ++i) {
-        if (keycode == custom_shift_keys[i].keycode) {
-          registered_keycode = custom_shift_keys[i].shifted_keycode;
-          if (IS_QK_MODS(registered_keycode) &&  // Should keycode be shifted?
-              (QK_MODS_GET_MODS(registered_keycode) & MOD_LSFT) != 0) {
-            register_code16(registered_keycode);  // If so, press it directly.
-          } else {
-            // Otherwise cancel shift mods, press the key, and restore mods.
-            del_weak_mods(MOD_MASK_SHIFT);
+      // Look up the custom shift key whose keycode is `keycode`.
+      const uint16_t shifted_keycode = custom_shift_key_lookup(keycode);
+      if (shifted_keycode != KC_NO) {
+        registered_keycode = shifted_keycode;
+        if (IS_QK_MODS(registered_keycode) &&  // Should keycode be shifted?
+            (QK_MODS_GET_MODS(registered_keycode) & MOD_LSFT) != 0) {
+          register_code16(registered_keycode);  // If so, press it directly.
+        } else {
+          // Otherwise cancel shift mods, press the key, and restore mods.
+          del_weak_mods(MOD_MASK_SHIFT);
 #ifndef NO_ACTION_ONESHOT
-            del_oneshot_mods(MOD_MASK_SHIFT);
+          del_oneshot_mods(MOD_MASK_SHIFT);
 #endif  // NO_ACTION_ONESHOT
-            unregister_mods(MOD_MASK_SHIFT);
-            register_code16(registered_keycode);
-            set_mods(saved_mods);
-          }
-          return false;
+          unregister_mods(MOD_MASK_SHIFT);
+          register_code16(registered_keycode);
+          set_mods(event->real_mods);
         }
+        return false;
       }
     }
   }
@@ -22,29 +22,36 @@
  * This library implements custom shift keys, keys where you can customize
  * what keycode is produced when shifted.
  *
- * Step 1: In your keymap.c, define a table of custom shift keys like
+ * Step 1: In your keymap.c, list your custom shift keys and declare the table
+ * like
  *
  *     #include "features/custom_shift_keys.h"
  *
- *     const custom_shift_key_t custom_shift_keys[] = {
- *       {KC_DOT , KC_QUES}, // Shift . is ?
- *       {KC_COMM, KC_EXLM}, // Shift , is !
- *       {KC_MINS, KC_EQL }, // Shift - is =
- *       {KC_COLN, KC_SCLN}, // Shift : is ;
- *     };
+ *     #define MY_CUSTOM_SHIFT_KEYS(X) \
+ *       X(KC_DOT , KC_QUES)           \
+ *       X(KC_COMM, KC_EXLM)           \
+ *       X(KC_MINS, KC_EQL )           \
+ *       X(KC_COLN, KC_SCLN)
+ *
+ *     CUSTOM_SHIFT_KEYS(MY_CUSTOM_SHIFT_KEYS);
  *
- * Each row defines one key. The first field is the keycode as it appears in
+ * Each entry defines one key. The first field is the keycode as it appears in
  * your layout and determines what is typed normally. The second entry is what
- * you want the key to type when shifted.
+ * you want the key to type when shifted. Since the list is a macro, comments
+ * inside it must be block comments.
  *
- * Step 2: Handle custom shift keys from your `process_record_user` function as
+ * The list is expanded both into the `custom_shift_keys` table and into a
+ * `switch` over the keys, which the compiler turns into a jump table or a
+ * binary search. Lookups therefore do not grow linearly with the table, and a
+ * key listed twice is a compile error ("duplicate case value").
  *
- *     bool process_record_user(uint16_t keycode, keyrecord_t* record) {
- *       if (!process_custom_shift_keys(keycode, record)) { return false; }
- *       // Your macros ...
+ * Step 2: Register the handler for every keycode in your `key_handlers` table
+ * (see key_event.h), as it releases the key it typed on the next event:
  *
- *       return true;
- *     }
+ *     const key_handler_t key_handlers[] = {
+ *       KEY_HANDLER(0, UINT16_MAX, process_custom_shift_keys),
+ *       // Your macros ...
+ *     };
  *
  * Step 3: add `features/custom_shift_keys.c` to your rules.mk as
  *
@@ -58,6 +65,7 @@
 #pragma once
 
 #include "quantum.h"
+#include "key_event.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -79,20 +87,43 @@ extern const custom_shift_key_t custom_shift_keys[];
 extern uint8_t NUM_CUSTOM_SHIFT_KEYS;
 
 /**
- * Handler function for custom shift keys.
- *
- * In keymap.c, call this function from your `process_record_user` function as
- *
- *     #include "features/custom_shift_keys.h"
- *
- *     bool process_record_user(uint16_t keycode, keyrecord_t* record) {
- *       if (!process_custom_shift_keys(keycode, record)) { return false; }
- *       // Your macros ...
- *
- *       return true;
- *     }
+ * Returns the shifted keycode for `keycode`, or KC_NO if `keycode` is not a
+ * custom shift key. Defined by `CUSTOM_SHIFT_KEYS()`.
+ */
+uint16_t custom_shift_key_lookup(uint16_t keycode);
+
+#define CUSTOM_SHIFT_KEY_ENTRY_(keycode, shifted_keycode) \
+  {(keycode), (shifted_keycode)},
+#define CUSTOM_SHIFT_KEY_CASE_(keycode, shifted_keycode) \
+  case (keycode):                                        \
+    return (shifted_keycode);
+
+/**
+ * Defines `custom_shift_keys`, `NUM_CUSTOM_SHIFT_KEYS` and
+ * `custom_shift_key_lookup()` from an X-macro list of (keycode,
+ * shifted_keycode) entries.
+ */
+#define CUSTOM_SHIFT_KEYS(list)                                          \
+  const custom_shift_key_t custom_shift_keys[] = {                       \
+      list(CUSTOM_SHIFT_KEY_ENTRY_)};                                    \
+  uint8_t NUM_CUSTOM_SHIFT_KEYS =                                        \
+      sizeof(custom_shift_keys) / sizeof(custom_shift_key_t);            \
+  uint16_t custom_shift_key_lookup(uint16_t keycode) {                   \
+    switch (keycode) {                                                   \
+      list(CUSTOM_SHIFT_KEY_CASE_)                                       \
+      default:                                                           \
+        return KC_NO;                                                    \
+    }                                                                    \
+  }                                                                      \
+  _Static_assert(sizeof(custom_shift_keys) / sizeof(custom_shift_key_t) \
+                     <= UINT8_MAX,                                       \
+                 "custom_shift_keys: too many entries")
+
+/**
+ * Handler function for custom shift keys, for the `key_handlers` table. Shift
+ * and the other mods are those of the `event` snapshot.
  */
-bool process_custom_shift_keys(uint16_t keycode, keyrecord_t *record);
+bool process_custom_shift_keys(const key_event_t *event, keyrecord_t *record);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,48 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "eager_dance.h"
+#include "keymap_util.h"
+
+// kc1 on odd taps, kc2 on even ones.
+static uint16_t keycode_for(tap_dance_pair_t *pair, uint8_t count) {
+    return count % 2 ? pair->kc1 : pair->kc2;
+}
+
+void eager_dance_on_each_tap(tap_dance_state_t *state, void *user_data) {
+    tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
+    if (state->count > 1) {
+        unregister_code16(keycode_for(pair, state->count - 1));
+        take_back();
+    }
+    register_code16(keycode_for(pair, state->count));
+}
+
+void eager_dance_on_each_release(tap_dance_state_t *state, void *user_data) {
+    tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
+    unregister_code16(keycode_for(pair, state->count));
+}
+
+bool is_eager_dance(uint16_t keycode) {
+    if (!IS_QK_TAP_DANCE(keycode) || QK_TAP_DANCE_GET_INDEX(keycode) >= tap_dance_count()) {
+        return false;
+    }
+    return tap_dance_actions[QK_TAP_DANCE_GET_INDEX(keycode)].fn.on_each_tap == eager_dance_on_each_tap;
+}
+
+void eager_dance_take_back(uint16_t keycode) {
+    const uint8_t      index = QK_TAP_DANCE_GET_INDEX(keycode);
+    tap_dance_state_t *state = tap_dance_get_state(index);
+    if (state == NULL || state->count == 0) {
+        return;
+    }
+    unregister_code16(keycode_for((tap_dance_pair_t *)tap_dance_actions[index].user_data, state->count));
+    take_back();
+}
+
+void eager_dance_reset(tap_dance_state_t *state, void *user_data) {
+    (void)state;
+    tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
+    unregister_code16(pair->kc1);
+    unregister_code16(pair->kc2);
+}
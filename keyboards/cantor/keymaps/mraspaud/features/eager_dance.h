@@ -0,0 +1,41 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Tap dances that type their first character right away.
+//
+// ACTION_TAP_DANCE_DOUBLE(kc1, kc2) can only type kc1 once the tapping term
+// has passed without a second tap, so the common character always comes
+// late. ACTION_TAP_DANCE_EAGER(kc1, kc2) presses kc1 with the first tap, as
+// a plain key would, and on a second tap within the term takes it back with
+// Backspace (sent without the mods held) and types kc2. Further taps within
+// the term go back and forth between the two, so that one tap too many
+// leaves a single character, never both:
+//
+//     tap_dance_action_t tap_dance_actions[] = {
+//         [TD_ADIA] = ACTION_TAP_DANCE_EAGER(EU_ADIA, EU_AE),
+//         [TD_ARRW] = ACTION_TAP_DANCE_DOUBLE(KC_MINS, KC_GT),
+//     };
+//
+// Each dance picks its variant: eager suits kc1 typing a single character
+// that Backspace erases, where the second tap is the rare one.
+//
+// A position combo on the key of an eager dance can type without delay too
+// (pos_combos.h): is_eager_dance() tells the combo engine to let the press
+// through, and eager_dance_take_back() erases it if the combo fires.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+void eager_dance_on_each_tap(tap_dance_state_t *state, void *user_data);
+void eager_dance_on_each_release(tap_dance_state_t *state, void *user_data);
+void eager_dance_reset(tap_dance_state_t *state, void *user_data);
+
+// Whether `keycode` is TD() of an ACTION_TAP_DANCE_EAGER dance.
+bool is_eager_dance(uint16_t keycode);
+
+// Erases the character the last tap of dance `keycode` typed.
+void eager_dance_take_back(uint16_t keycode);
+
+#define ACTION_TAP_DANCE_EAGER(kc1, kc2) \
+    { .fn = {eager_dance_on_each_tap, NULL, eager_dance_reset, eager_dance_on_each_release}, .user_data = (void *)&((tap_dance_pair_t){kc1, kc2}), }
@@ -0,0 +1,37 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "expansions.h"
+#include "output_queue.h"
+#include "unicode_sequences.h"
+
+expansion_case_t expansion_case(const key_event_t *event) {
+    if (event->caps_word) {
+        return EXPANSION_UPPER;
+    }
+    if (event->shift) {
+        return EXPANSION_TITLE;
+    }
+    return EXPANSION_LOWER;
+}
+
+void send_expansion(const key_event_t *event, uint8_t index) {
+    if (!event->pressed || index >= NUM_EXPANSIONS) {
+        return;
+    }
+    char text[EXPANSION_LENGTH];
+    memcpy_P(text, expansions[index].text[expansion_case(event)], EXPANSION_LENGTH);
+
+    // The texts carry their own case: type them without Shift. A one-shot
+    // Shift is used up, as it would be by a single key.
+    const uint8_t mods = event->mods & ~MOD_MASK_SHIFT;
+    output_queue_begin();
+    for (uint8_t i = 0; i < EXPANSION_LENGTH && text[i] != '\0'; i++) {
+        if (text[i] & 0x80) {
+            send_unicode_sequence(text[i] & 0x7F);
+        } else {
+            output_queue_char(text[i], mods);
+        }
+    }
+    output_queue_end();
+}
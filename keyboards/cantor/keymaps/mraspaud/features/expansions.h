@@ -0,0 +1,58 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Keys that type a few characters (digraphs such as "th"), in the case the
+// user asks for:
+//
+//   - with Caps Word on: all caps, "TH";
+//   - with Shift held or one-shot: title case, "Th", typed without Shift;
+//   - otherwise: lowercase, "th".
+//
+// The keymap gives its expansion keycodes contiguous values and a table in
+// the same order, so a key press is a single index into the table:
+//
+//     const expansion_t expansions[] PROGMEM = {
+//         [DI_TH - DI_TH] = {{"th", "Th", "TH"}},
+//     };
+//     uint8_t NUM_EXPANSIONS = ARRAY_SIZE(expansions);
+//
+//     case DI_TH ... DI_LAST:
+//         send_expansion(event, keycode - DI_TH);
+//
+// The case comes from the key_event.h snapshot of the key typing it.
+//
+// Texts are ASCII, except that EXPANSION_GLYPH(i) stands for glyph i of the
+// unicode_sequences table, e.g. {'o', EXPANSION_GLYPH(UGRV)} for "où".
+//
+// A text is queued on output_queue.h and goes out as one hid_batch.h batch:
+// "th" is a report pressing both keys and one releasing them.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "key_event.h"
+
+// Longest text, in characters and glyphs.
+#define EXPANSION_LENGTH 3
+
+typedef enum {
+    EXPANSION_LOWER,
+    EXPANSION_TITLE,
+    EXPANSION_UPPER,
+    EXPANSION_CASES,
+} expansion_case_t;
+
+typedef struct {
+    char text[EXPANSION_CASES][EXPANSION_LENGTH];
+} expansion_t;
+
+#define EXPANSION_GLYPH(index) ((char)(0x80 | (index)))
+
+extern const expansion_t expansions[];
+extern uint8_t           NUM_EXPANSIONS;
+
+// The case an expansion typed by `event` uses.
+expansion_case_t expansion_case(const key_event_t *event);
+
+// Types expansion `index` on the press of `event`.
+void send_expansion(const key_event_t *event, uint8_t index);
@@ -0,0 +1,56 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// The finger, row and column each key is typed with, for decisions that
+// depend on how a chord is reached rather than on what it types.
+//
+// The keymap lists every key in LAYOUT order:
+//
+//     const finger_key_t finger_model[FINGER_MODEL_KEYS] = {
+//         {FINGER_LEFT_PINKY, 0, 0}, {FINGER_LEFT_PINKY, 0, 1}, ...
+//     };
+//
+// Fingers count from the left pinky to the right pinky, the thumbs in the
+// middle; rows from the top, the thumb cluster being FINGER_MODEL_THUMB_ROW;
+// columns from the left edge of the board.
+//
+// The firmware does not read the model: sim/chordal.c compiles it into
+// chordal_hold.h, one bit per (tap-hold key, other key) pair, and the
+// simulator's tools use it to tell fingers apart. The hand of a thumb only
+// matters to the tools: chordal hold lets any mod chord with either thumb.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#define FINGER_MODEL_KEYS 42
+#define FINGER_MODEL_THUMB_ROW 3
+
+enum finger {
+    FINGER_LEFT_PINKY,
+    FINGER_LEFT_RING,
+    FINGER_LEFT_MIDDLE,
+    FINGER_LEFT_INDEX,
+    FINGER_LEFT_THUMB,
+    FINGER_RIGHT_THUMB,
+    FINGER_RIGHT_INDEX,
+    FINGER_RIGHT_MIDDLE,
+    FINGER_RIGHT_RING,
+    FINGER_RIGHT_PINKY,
+};
+
+typedef struct {
+    uint8_t finger;
+    uint8_t row;
+    uint8_t col;
+} finger_key_t;
+
+extern const finger_key_t finger_model[FINGER_MODEL_KEYS];
+
+static inline bool finger_is_left(uint8_t finger) {
+    return finger <= FINGER_LEFT_THUMB;
+}
+
+static inline bool finger_is_thumb(uint8_t finger) {
+    return finger == FINGER_LEFT_THUMB || finger == FINGER_RIGHT_THUMB;
+}
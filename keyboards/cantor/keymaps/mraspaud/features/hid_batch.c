@@ -0,0 +1,159 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "hid_batch.h"
+
+static uint8_t depth = 0;
+static uint8_t saved_mods;
+static uint8_t saved_weak_mods;
+static uint8_t batch_mods;  // The mods as the batch last set them.
+
+// Keys the batch holds down, in the order they were pressed, and whether
+// the report pressing them is still to be sent.
+static uint8_t down[HID_BATCH_MAX_KEYS];
+static uint8_t down_count = 0;
+static bool    unsent     = false;
+
+static bool nkro_on(void) {
+#ifdef NKRO_ENABLE
+    return host_can_send_nkro() && keymap_config.nkro;
+#else
+    return false;
+#endif
+}
+
+// Whether `keycode` is down in the report, held by the batch or by the user.
+static bool in_report(uint8_t keycode) {
+#ifdef NKRO_ENABLE
+    if (nkro_on()) {
+        return (nkro_report->bits[keycode >> 3] & (1 << (keycode & 7))) != 0;
+    }
+#endif
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard_report->keys[i] == keycode) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool report_full(void) {
+    if (down_count >= HID_BATCH_MAX_KEYS) {
+        return true;
+    }
+    if (nkro_on()) {
+        return false;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard_report->keys[i] == KC_NO) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether `keycode` can join the report being built: the host must see it
+// pressed after the keys already in it, with the same mods.
+static bool joins(uint8_t keycode, uint8_t mods) {
+    return mods == get_mods() && !in_report(keycode) && !report_full() && (!nkro_on() || keycode > down[down_count - 1]);
+}
+
+// Takes into saved_mods the mods changed behind the batch's back, such as a
+// tap-hold key settling as a hold while output_queue.h drains a macro: they
+// are the user's, and stay as they are when the batch ends.
+static void keep_user_mods(void) {
+    const uint8_t changed = get_mods() ^ batch_mods;
+    saved_mods            = (saved_mods & ~changed) | (get_mods() & changed);
+    batch_mods            = get_mods();
+}
+
+static void release_down(void) {
+    for (uint8_t i = 0; i < down_count; i++) {
+        del_key(down[i]);
+    }
+    down_count = 0;
+}
+
+static void send_pending(void) {
+    if (unsent) {
+        send_keyboard_report();
+        unsent = false;
+    }
+}
+
+bool hid_batch_joins(uint8_t keycode, uint8_t mods) {
+    return unsent && joins(keycode, mods);
+}
+
+void hid_batch_send(void) {
+    send_pending();
+}
+
+void hid_batch_begin(void) {
+    if (depth++ > 0) {
+        return;
+    }
+    saved_mods      = get_mods();
+    saved_weak_mods = get_weak_mods();
+    batch_mods      = saved_mods;
+    clear_weak_mods();
+    clear_oneshot_mods();
+    down_count = 0;
+    unsent     = false;
+}
+
+void hid_batch_tap(uint8_t keycode, uint8_t mods) {
+    if (unsent && !joins(keycode, mods)) {
+        send_pending();
+    }
+    if (!unsent) {
+        // The new report releases the keys of the last one. A key that is
+        // down already is released in a report of its own first.
+        const bool repeated = in_report(keycode);
+        release_down();
+        if (repeated) {
+            del_key(keycode);
+            send_keyboard_report();
+        }
+        keep_user_mods();
+        set_mods(mods);
+        batch_mods = mods;
+        unsent     = true;
+    }
+    add_key(keycode);
+    down[down_count++] = keycode;
+}
+
+void hid_batch_char(char c, uint8_t mods) {
+    if ((uint8_t)c >= 128) {
+        return;
+    }
+    const uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)c]);
+    if (pgm_read_byte(&ascii_to_shift_lut[(uint8_t)c / 8]) & (1 << ((uint8_t)c % 8))) {
+        mods |= MOD_BIT(KC_LSFT);
+    }
+    hid_batch_tap(keycode, mods);
+}
+
+void hid_batch_flush(void) {
+    send_pending();
+    if (down_count > 0) {
+        release_down();
+        send_keyboard_report();
+    }
+}
+
+void hid_batch_end(void) {
+    if (depth == 0 || --depth > 0) {
+        return;
+    }
+    // The mods come back with the release of the last keys: only those the
+    // batch changed, so that one pressed meanwhile is not released.
+    send_pending();
+    release_down();
+    keep_user_mods();
+    del_mods(batch_mods & ~saved_mods);
+    add_mods(saved_mods & ~batch_mods);
+    add_weak_mods(saved_weak_mods);
+    send_keyboard_report();
+}
@@ -0,0 +1,57 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Macro output packed into as few keyboard reports as the host reads back
+// in the right order.
+//
+// Tapping every character of a macro costs two reports, a press and a
+// release, and a mod change in between costs more: "th" is four reports,
+// one USB polling interval each. The host types the keys newly pressed in a
+// report one after the other, in report order and with the report's mods,
+// so keystrokes that share their mods can go out pressed together:
+//
+//     hid_batch_begin();
+//     hid_batch_char('t', 0);
+//     hid_batch_char('h', 0);
+//     hid_batch_end();
+//
+// sends {t h} then {}. A new report is started when the mods change, when
+// a key is already down (a repeated letter is released in a report of its
+// own first), and when the report is full: six keys, or the free slots
+// left by keys held on the keyboard. With NKRO the report is a bitmap the
+// host reads in usage order, so a report only takes keys in increasing
+// order there.
+//
+// Batches nest: only the outermost hid_batch_end() sends the last report.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#ifndef HID_BATCH_MAX_KEYS
+#    define HID_BATCH_MAX_KEYS 6
+#endif
+
+// Starts a batch. Mods are saved, and one-shot mods are used up, as by a
+// single key: the keystrokes carry all their mods themselves.
+void hid_batch_begin(void);
+
+// Taps basic keycode `keycode` (not a modifier) with 8-bit mods `mods`.
+void hid_batch_tap(uint8_t keycode, uint8_t mods);
+
+// Taps ASCII `c`, adding Shift to `mods` where send_string() would.
+void hid_batch_char(char c, uint8_t mods);
+
+// Whether tapping `keycode` with `mods` now would add it to the report being
+// built, rather than send that report first.
+bool hid_batch_joins(uint8_t keycode, uint8_t mods);
+
+// Sends the report being built, keeping its keys down.
+void hid_batch_send(void);
+
+// Sends what is pending and releases it, e.g. before waiting on the host.
+void hid_batch_flush(void);
+
+// Releases everything and restores the mods the batch changed. Mods changed
+// meanwhile from outside the batch are left as they are.
+void hid_batch_end(void);
@@ -0,0 +1,47 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "key_event.h"
+
+static uint16_t tap_keycode(uint16_t keycode, keyrecord_t *record) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        return record->tap.count > 0 ? QK_MOD_TAP_GET_TAP_KEYCODE(keycode) : KC_NO;
+    }
+    if (IS_QK_LAYER_TAP(keycode)) {
+        return record->tap.count > 0 ? QK_LAYER_TAP_GET_TAP_KEYCODE(keycode) : KC_NO;
+    }
+    return keycode;
+}
+
+key_event_t key_event_snapshot(uint16_t keycode, keyrecord_t *record) {
+    const uint8_t real_mods = get_mods();
+#ifndef NO_ACTION_ONESHOT
+    const uint8_t mods = real_mods | get_weak_mods() | get_oneshot_mods();
+#else
+    const uint8_t mods = real_mods | get_weak_mods();
+#endif
+    return (key_event_t){
+        .keycode     = keycode,
+        .tap_keycode = tap_keycode(keycode, record),
+        .mods        = mods,
+        .real_mods   = real_mods,
+        // Combos have no key to look up.
+        .layer   = record->event.type == KEY_EVENT ? read_source_layers_cache(record->event.key) : get_highest_layer(layer_state | default_layer_state),
+        .shift   = (mods & MOD_MASK_SHIFT) != 0,
+#ifdef CAPS_WORD_ENABLE
+        .caps_word = is_caps_word_on(),
+#endif
+        .pressed = record->event.pressed,
+    };
+}
+
+bool process_key_handlers(const key_event_t *event, keyrecord_t *record) {
+    const uint16_t keycode = event->keycode;
+    for (uint8_t i = 0; i < NUM_KEY_HANDLERS; i++) {
+        const key_handler_t *entry = &key_handlers[i];
+        if (keycode >= entry->first && keycode <= entry->last && !entry->handler(event, record)) {
+            return false;
+        }
+    }
+    return true;
+}
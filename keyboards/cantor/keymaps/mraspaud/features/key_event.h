@@ -0,0 +1,70 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// One snapshot of the keyboard state per key event, and the handlers of
+// process_record_user() run against it.
+//
+// The handlers all want to know the mods (real, weak and one-shot), whether
+// Shift is among them, whether Caps Word is on and which layer the key came
+// from. key_event_snapshot() reads them once per event, together with what
+// the key types, and the handlers get that snapshot instead of asking QMK
+// again each:
+//
+//     bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+//         const key_event_t event = key_event_snapshot(keycode, record);
+//         return process_key_handlers(&event, record);
+//     }
+//
+// The keymap registers its handlers in key_handlers[], each with the range
+// of keycodes it handles. process_key_handlers() runs, in table order, the
+// handlers whose range holds the event's keycode, until one returns false;
+// the others are not called for that key at all:
+//
+//     const key_handler_t key_handlers[] = {
+//         KEY_HANDLER(0, UINT16_MAX, process_custom_shift_keys),  // Every key.
+//         KEY_HANDLER(DI_TH, DI_LAST, process_expansion_keys),
+//         KEY_HANDLER(QK_UNICODEMAP, QK_UNICODEMAP_PAIR_MAX, process_unicode_sequences),
+//     };
+//     uint8_t NUM_KEY_HANDLERS = ARRAY_SIZE(key_handlers);
+//
+// Give a handler only the keycodes it acts on, one entry per keycode when
+// they are scattered: a range over keys it ignores costs a call per key.
+// Handlers that must see every event, to release a key or time one, take
+// 0 to UINT16_MAX.
+//
+// A handler may register keys or change mods, but the snapshot stays what it
+// was when the event came in: handlers after it see the same event.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+typedef struct {
+    uint16_t keycode;      // As given to process_record_user().
+    uint16_t tap_keycode;  // What the key types: a tapped tap-hold key's tap, KC_NO when held.
+    uint8_t  mods;         // Real, weak and one-shot.
+    uint8_t  real_mods;    // Real only, for handlers that put them back.
+    uint8_t  layer;        // The layer the key was found on.
+    bool     shift;        // Shift among `mods`.
+    bool     caps_word;
+    bool     pressed;
+} key_event_t;
+
+typedef bool (*key_handler_fn_t)(const key_event_t *event, keyrecord_t *record);
+
+typedef struct {
+    uint16_t         first;  // Keycodes handled, both included.
+    uint16_t         last;
+    key_handler_fn_t handler;
+} key_handler_t;
+
+#define KEY_HANDLER(first, last, fn) {(first), (last), (fn)}
+
+extern const key_handler_t key_handlers[];
+extern uint8_t             NUM_KEY_HANDLERS;
+
+// Reads the state the handlers of `record` need.
+key_event_t key_event_snapshot(uint16_t keycode, keyrecord_t *record);
+
+// Runs the handlers of `event->keycode`; returns false as soon as one does.
+bool process_key_handlers(const key_event_t *event, keyrecord_t *record);
@@ -0,0 +1,145 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "key_history.h"
+
+_Static_assert((KEY_HISTORY_SIZE & (KEY_HISTORY_SIZE - 1)) == 0, "KEY_HISTORY_SIZE must be a power of two");
+
+typedef struct {
+    uint16_t keycode;
+    uint32_t time;  // 32 bits: a 16-bit age would wrap to "just now" after 65 s.
+    uint8_t  mods;
+} keystroke_t;
+
+static keystroke_t history[KEY_HISTORY_SIZE];
+static uint8_t     last  = 0;  // Index of keystroke 0.
+static uint8_t     count = 0;
+
+// word[i] is the hash of the first i letters of the word, so Backspace
+// takes the hash back in one step.
+static uint16_t word[KEY_HISTORY_WORD_MAX + 1];
+static uint8_t  word_length = 0;
+static bool     overflowed  = false;  // Letters were typed past KEY_HISTORY_WORD_MAX.
+
+__attribute__((weak)) bool key_history_in_word(uint16_t keycode) {
+    (void)keycode;
+    return false;
+}
+
+static uint16_t hash_step(uint16_t hash, uint16_t keycode) {
+    return (uint16_t)((hash << 5) + hash) ^ keycode;
+}
+
+uint16_t key_history_hash(const uint16_t *keycodes, uint8_t count) {
+    uint16_t hash = KEY_HISTORY_EMPTY_HASH;
+    for (uint8_t i = 0; i < count; i++) {
+        hash = hash_step(hash, keycodes[i]);
+    }
+    return hash;
+}
+
+static void end_word(void) {
+    word_length = 0;
+    overflowed  = false;
+}
+
+void key_history_init(void) {
+    count   = 0;
+    word[0] = KEY_HISTORY_EMPTY_HASH;
+    end_word();
+}
+
+static bool is_letter(uint16_t keycode) {
+    if (IS_QK_MODS(keycode)) {
+        keycode = QK_MODS_GET_BASIC_KEYCODE(keycode);
+    }
+    return (keycode >= KC_A && keycode <= KC_Z) || key_history_in_word(keycode);
+}
+
+static void update_word(uint16_t keycode, uint8_t mods) {
+    if (keycode == KC_BSPC && !(mods & (MOD_MASK_CTRL | MOD_MASK_ALT))) {
+        if (overflowed || word_length == 0) {
+            end_word();
+        } else {
+            word_length--;
+        }
+    } else if (is_letter(keycode)) {
+        if (word_length < KEY_HISTORY_WORD_MAX) {
+            word[word_length + 1] = hash_step(word[word_length], keycode);
+            word_length++;
+        } else {
+            word[word_length] = hash_step(word[word_length], keycode);
+            overflowed        = true;
+        }
+    } else {
+        end_word();
+    }
+}
+
+// When `record` was pressed, on the 32-bit clock. QMK stamps events with the
+// low 16 bits of the time, so take the event's age on that clock and count
+// it back from the 32-bit one; an event is never more than a tapping term
+// old. The stamp has its low bit forced on and can be 1 ms in the future,
+// which makes the age negative: that counts as now.
+static uint32_t press_time(keyrecord_t *record) {
+    const int16_t age = (int16_t)TIMER_DIFF_16(timer_read(), record->event.time);
+    return age > 0 ? timer_read32() - age : timer_read32();
+}
+
+void key_history_record(const key_event_t *event, keyrecord_t *record) {
+    if (!event->pressed) {
+        return;
+    }
+    // Holds of tap-hold keys have no tap keycode.
+    const uint16_t keycode = event->tap_keycode;
+    if (keycode == KC_NO || IS_MODIFIER_KEYCODE(keycode) || IS_QK_TO(keycode) || IS_QK_MOMENTARY(keycode) || IS_QK_ONE_SHOT_LAYER(keycode) || IS_QK_ONE_SHOT_MOD(keycode)) {
+        return;
+    }
+    const uint8_t mods = event->mods;
+    last               = (last + 1) & (KEY_HISTORY_SIZE - 1);
+    history[last]      = (keystroke_t){.keycode = keycode, .time = press_time(record), .mods = mods};
+    if (count < KEY_HISTORY_SIZE) {
+        count++;
+    }
+    update_word(keycode, mods);
+}
+
+static const keystroke_t *at(uint8_t n) {
+    return n < count ? &history[(last - n) & (KEY_HISTORY_SIZE - 1)] : NULL;
+}
+
+uint16_t key_history_keycode(uint8_t n) {
+    const keystroke_t *keystroke = at(n);
+    return keystroke != NULL ? keystroke->keycode : KC_NO;
+}
+
+uint8_t key_history_mods(uint8_t n) {
+    const keystroke_t *keystroke = at(n);
+    return keystroke != NULL ? keystroke->mods : 0;
+}
+
+uint16_t key_history_age(uint8_t n) {
+    const keystroke_t *keystroke = at(n);
+    if (keystroke == NULL) {
+        return UINT16_MAX;
+    }
+    const uint32_t age = timer_elapsed32(keystroke->time);
+    return age < UINT16_MAX ? age : UINT16_MAX;
+}
+
+uint16_t key_history_since(uint16_t keycode) {
+    for (uint8_t n = 0; n < count; n++) {
+        if (at(n)->keycode == keycode) {
+            return key_history_age(n);
+        }
+    }
+    return UINT16_MAX;
+}
+
+uint8_t key_history_word_length(void) {
+    return word_length;
+}
+
+uint16_t key_history_word_hash(void) {
+    return word[word_length];
+}
@@ -0,0 +1,70 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// The last keystrokes typed, for features that depend on what came before.
+//
+// Every key press that types something goes into a ring of the last
+// KEY_HISTORY_SIZE keystrokes, with its mods and time: plain keys, the taps
+// of tap-hold keys (as their tap keycode), combos, macros. Holds, modifiers
+// and layer keys are left out, so "the key before" is the one typed before,
+// whatever was held or switched in between. Along with it goes a hash of the
+// word being typed, kept up to date as letters are added and erased.
+//
+//     // q, but not vim's :q
+//     if (keycode == KC_Q && key_history_keycode(0) != EU_COLN) { ... }
+//
+//     // a letter typed less than 300 ms ago: prose
+//     if (key_history_word_length() > 0 && key_history_age(0) < 300) { ... }
+//
+//     // "the" typed just now
+//     static const uint16_t the[] = {KC_T, KC_H, KC_E};
+//     if (key_history_word_hash() == key_history_hash(the, 3)) { ... }
+//
+// Every query is constant time: key_history_since() looks at most at
+// KEY_HISTORY_SIZE entries, the others at one.
+//
+// Call key_history_record() last thing in process_record_user(), so that
+// while a key is processed, entry 0 is the key before it. Word keys are the
+// letters KC_A to KC_Z, with or without mods; the keymap can list more in
+// key_history_in_word(). Backspace takes a letter off the word and any other
+// keystroke ends it.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "key_event.h"
+
+#ifndef KEY_HISTORY_SIZE
+#    define KEY_HISTORY_SIZE 16  // A power of two.
+#endif
+#ifndef KEY_HISTORY_WORD_MAX
+#    define KEY_HISTORY_WORD_MAX 24  // Letters of the word that Backspace can go back over.
+#endif
+
+// Forgets everything.
+void key_history_init(void);
+
+// Records the press of `event` if it typed something, with its mods.
+void key_history_record(const key_event_t *event, keyrecord_t *record);
+
+// Keystroke `n` back, 0 being the last one; KC_NO beyond the history.
+uint16_t key_history_keycode(uint8_t n);
+// Its mods: real, weak and one-shot.
+uint8_t key_history_mods(uint8_t n);
+// ms since it was typed, UINT16_MAX beyond the history or from that long ago.
+uint16_t key_history_age(uint8_t n);
+
+// ms since `keycode` was last typed, UINT16_MAX if it is not in the history.
+uint16_t key_history_since(uint16_t keycode);
+
+// The word typed so far: its length and hash, 0 and KEY_HISTORY_EMPTY_HASH
+// outside a word.
+uint8_t  key_history_word_length(void);
+uint16_t key_history_word_hash(void);
+
+// The hash of a word of `count` keycodes, to compare with the one above.
+#define KEY_HISTORY_EMPTY_HASH 5381
+uint16_t key_history_hash(const uint16_t *keycodes, uint8_t count);
+
+// Whether `keycode` is part of words, beyond the letters. Defaults to false.
+bool key_history_in_word(uint16_t keycode);
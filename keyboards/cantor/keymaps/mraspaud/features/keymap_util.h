@@ -0,0 +1,34 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Helpers shared by the keymap and its features.
+//
+// Layer masks are built with LAYER_BIT(). Sets of keys are 64-bit
+// position_set_t, with bit POSITION_BIT(p) for key p: p is whatever numbering
+// the set is kept in, a combo position or MATRIX_INDEX() of the matrix key.
+// take_back() erases the character just typed.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#define LAYER_BIT(layer) ((layer_state_t)1 << (layer))
+
+typedef uint64_t position_set_t;
+
+#define POSITION_BIT(position) ((position_set_t)1 << (position))
+
+// Matrix keys numbered row by row, for sets that cover the whole matrix.
+#define MATRIX_INDEX(key) ((key).row * MATRIX_COLS + (key).col)
+
+// Taps Backspace with no mods held: Ctrl or Alt would make it erase a word,
+// and Shift held for a capital is not meant for it either.
+static inline void take_back(void) {
+    const uint8_t mods      = get_mods();
+    const uint8_t weak_mods = get_weak_mods();
+    clear_mods();
+    clear_weak_mods();
+    tap_code(KC_BSPC);
+    set_mods(mods);
+    set_weak_mods(weak_mods);
+}
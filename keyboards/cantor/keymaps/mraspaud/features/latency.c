@@ -0,0 +1,204 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "latency.h"
+
+#include <ch.h>
+
+#ifdef RAW_ENABLE
+#    include "raw_hid.h"
+#endif
+#include "timeouts.h"
+
+#define TICKS_PER_US (STM32_SYSCLK / 1000000U)
+
+static latency_histogram_t histograms[LATENCY_STAGES];
+
+// When each key was last seen going down and up, in cycle counter ticks.
+static uint32_t pressed_at[MATRIX_ROWS][MATRIX_COLS];
+static uint32_t released_at[MATRIX_ROWS][MATRIX_COLS];
+
+static uint32_t user_entered;
+
+// The processed press still waiting for a keyboard report.
+static bool     report_pending = false;
+static keypos_t report_key;
+static uint32_t report_pressed_at;
+
+static host_driver_t  timed_driver;
+static host_driver_t *host_driver = NULL;
+
+static uint32_t ticks(void) {
+    return chSysGetRealtimeCounterX();
+}
+
+static void add(uint8_t stage, uint32_t since) {
+    const uint32_t       us        = (ticks() - since) / TICKS_PER_US;
+    latency_histogram_t *histogram = &histograms[stage];
+    uint8_t              bucket    = us == 0 ? 0 : 32 - __builtin_clz(us);
+    if (bucket >= LATENCY_BUCKETS) {
+        bucket = LATENCY_BUCKETS - 1;
+    }
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    histogram->total_us += us;
+    if (us > histogram->max_us) {
+        histogram->max_us = us;
+    }
+}
+
+static bool on_matrix(keypos_t key) {
+    return key.row < MATRIX_ROWS && key.col < MATRIX_COLS;
+}
+
+static void send_keyboard_timed(report_keyboard_t *report) {
+    host_driver->send_keyboard(report);
+    if (report_pending) {
+        add(LATENCY_REPORT, report_pressed_at);
+        report_pending = false;
+    }
+}
+
+// The USB driver is set after keyboard_post_init_user() has run, so it is
+// wrapped on the first key event instead.
+static void wrap_host_driver(void) {
+    host_driver_t *driver = host_get_driver();
+    if (driver == NULL || driver == &timed_driver) {
+        return;
+    }
+    host_driver                = driver;
+    timed_driver               = *driver;
+    timed_driver.send_keyboard = send_keyboard_timed;
+    host_set_driver(&timed_driver);
+}
+
+#ifdef CONSOLE_ENABLE
+static timeout_t print_delay = TIMEOUT_INIT(latency_print);
+#endif
+
+void latency_init(void) {
+    latency_reset();
+}
+
+void latency_reset(void) {
+    memset(histograms, 0, sizeof(histograms));
+    report_pending = false;
+}
+
+const latency_histogram_t *latency_histogram(uint8_t stage) {
+    return stage < LATENCY_STAGES ? &histograms[stage] : NULL;
+}
+
+void latency_event_seen(keyrecord_t *record) {
+    const keypos_t key = record->event.key;
+    if (!on_matrix(key)) {
+        return;
+    }
+    wrap_host_driver();
+    if (record->event.pressed) {
+        pressed_at[key.row][key.col] = ticks();
+    } else {
+        released_at[key.row][key.col] = ticks();
+    }
+#ifdef CONSOLE_ENABLE
+    timeout_start(&print_delay, LATENCY_PRINT_IDLE);
+#endif
+}
+
+static bool is_tap_hold(uint16_t keycode) {
+    switch (keycode) {
+        case QK_MOD_TAP ... QK_MOD_TAP_MAX:
+        case QK_LAYER_TAP ... QK_LAYER_TAP_MAX:
+            return true;
+    }
+    return false;
+}
+
+void latency_user_enter(uint16_t keycode, keyrecord_t *record) {
+    const keypos_t key = record->event.key;
+    if (on_matrix(key)) {
+        if (record->event.pressed) {
+            const uint32_t seen = pressed_at[key.row][key.col];
+            if (!is_tap_hold(keycode)) {
+                add(LATENCY_QUEUE, seen);
+            } else {
+                add(record->tap.count > 0 ? LATENCY_TAP : LATENCY_HOLD, seen);
+            }
+            report_pending    = true;
+            report_key        = key;
+            report_pressed_at = seen;
+        } else if (report_pending && KEYEQ(key, report_key)) {
+            // Released without sending anything, as layer keys do.
+            report_pending = false;
+        }
+    }
+    user_entered = ticks();
+}
+
+void latency_user_exit(keyrecord_t *record) {
+    add(LATENCY_USER, user_entered);
+}
+
+static const char *const stage_names[LATENCY_STAGES] = {"queue", "tap", "hold", "user", "report"};
+
+void latency_print(void) {
+    for (uint8_t stage = 0; stage < LATENCY_STAGES; stage++) {
+        const latency_histogram_t *histogram = &histograms[stage];
+        uprintf("latency %s %lu %lu %lu", stage_names[stage], (unsigned long)histogram->count, (unsigned long)histogram->max_us, (unsigned long)histogram->total_us);
+        for (uint8_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+            uprintf(" %lu", (unsigned long)histogram->buckets[bucket]);
+        }
+        uprintf("\n");
+    }
+}
+
+#ifdef RAW_ENABLE
+static void put32(uint8_t *data, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+        data[i] = value >> (8 * i);
+    }
+}
+
+bool latency_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 4 || data[0] != LATENCY_RAW_ID) {
+        return false;
+    }
+    const uint8_t stage = data[2];
+    switch (data[1]) {
+        case LATENCY_RAW_INFO:
+            data[2] = LATENCY_STAGES;
+            data[3] = LATENCY_BUCKETS;
+            break;
+        case LATENCY_RAW_SUMMARY:
+            if (stage >= LATENCY_STAGES || length < 20) {
+                data[1] = 0xFF;
+                break;
+            }
+            data[3] = 0;
+            put32(&data[4], histograms[stage].count);
+            put32(&data[8], histograms[stage].max_us);
+            put32(&data[12], (uint32_t)histograms[stage].total_us);
+            put32(&data[16], (uint32_t)(histograms[stage].total_us >> 32));
+            break;
+        case LATENCY_RAW_BUCKETS: {
+            const uint8_t first = data[3];
+            if (stage >= LATENCY_STAGES || first >= LATENCY_BUCKETS) {
+                data[1] = 0xFF;
+                break;
+            }
+            for (uint8_t i = 0; i < (length - 4) / 4 && first + i < LATENCY_BUCKETS; i++) {
+                put32(&data[4 + 4 * i], histograms[stage].buckets[first + i]);
+            }
+            break;
+        }
+        case LATENCY_RAW_RESET:
+            latency_reset();
+            break;
+        default:
+            data[1] = 0xFF;
+            break;
+    }
+    raw_hid_send(data, length);
+    return true;
+}
+#endif
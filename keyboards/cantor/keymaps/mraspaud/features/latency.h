@@ -0,0 +1,108 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Latency histograms of the key event path, for instrumented builds.
+//
+// Every key event is timestamped when the keymap first sees it (in
+// pre_process_record_user, in the same scan as its matrix detection), on
+// entry to and exit from process_record_user, and when the next keyboard
+// report leaves for the host; the host driver is wrapped for that. The
+// delays land in per-stage histograms in RAM:
+//
+//     queue   press to process_record_user, plain keys (combo buffering)
+//     tap     press to process_record_user, tap-hold keys settled as taps
+//     hold    press to process_record_user, tap-hold keys settled as holds
+//     user    time spent in process_record_user, every event
+//     report  press to the first keyboard report after it was processed
+//
+// so for MT_E, "tap" is how long the tap-hold decision took and "report" is
+// when the "e" reached the host. Buckets are powers of two in microseconds,
+// timed with the Cortex-M cycle counter.
+//
+// tools/latency.py reads the histograms over raw HID, or parses the dump
+// printed on the console after every typing pause (CONSOLE_ENABLE).
+//
+// Build with LATENCY_ENABLE=yes (qmk compile -e LATENCY_ENABLE=yes). Without
+// it the hooks are empty inline functions and nothing is compiled in.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#define LATENCY_BUCKETS 20  // Last bucket: 2^18 µs (262 ms) and above.
+
+#ifndef LATENCY_PRINT_IDLE
+#    define LATENCY_PRINT_IDLE 5000
+#endif
+
+enum latency_stage {
+    LATENCY_QUEUE,
+    LATENCY_TAP,
+    LATENCY_HOLD,
+    LATENCY_USER,
+    LATENCY_REPORT,
+    LATENCY_STAGES,
+};
+
+typedef struct {
+    uint32_t buckets[LATENCY_BUCKETS];  // Bucket 0: 0 µs, bucket b: [2^(b-1), 2^b) µs.
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t total_us;
+} latency_histogram_t;
+
+// Raw HID requests, 32 bytes, answered in place. Byte 0 is LATENCY_RAW_ID.
+//
+//     INFO                    -> INFO, stages, buckets
+//     SUMMARY stage           -> SUMMARY, stage, 0, 0, count, max_us, total_us (LE)
+//     BUCKETS stage first     -> BUCKETS, stage, first, up to 7 counts (LE)
+//     RESET                   -> RESET
+//
+// Unknown requests are answered with 0xFF in byte 1.
+#define LATENCY_RAW_ID 'L'
+enum latency_raw_command {
+    LATENCY_RAW_INFO,
+    LATENCY_RAW_SUMMARY,
+    LATENCY_RAW_BUCKETS,
+    LATENCY_RAW_RESET,
+};
+
+#ifdef LATENCY_ENABLE
+
+void latency_init(void);
+void latency_reset(void);
+const latency_histogram_t *latency_histogram(uint8_t stage);
+
+// Call first thing in pre_process_record_user().
+void latency_event_seen(keyrecord_t *record);
+// Call around the body of process_record_user().
+void latency_user_enter(uint16_t keycode, keyrecord_t *record);
+void latency_user_exit(keyrecord_t *record);
+
+// Prints one "latency <stage> <count> <max> <total> <buckets...>" line per
+// stage.
+void latency_print(void);
+
+// Answers the raw HID requests tagged LATENCY_RAW_ID; returns false on others.
+bool latency_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#else
+
+static inline void latency_init(void) {}
+static inline void latency_event_seen(keyrecord_t *record) {
+    (void)record;
+}
+static inline void latency_user_enter(uint16_t keycode, keyrecord_t *record) {
+    (void)keycode;
+    (void)record;
+}
+static inline void latency_user_exit(keyrecord_t *record) {
+    (void)record;
+}
+static inline bool latency_raw_hid_receive(uint8_t *data, uint8_t length) {
+    (void)data;
+    (void)length;
+    return false;
+}
+
+#endif
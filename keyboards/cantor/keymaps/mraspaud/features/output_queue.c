@@ -0,0 +1,123 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "output_queue.h"
+
+#include "hid_batch.h"
+#include "timeouts.h"
+
+_Static_assert((OUTPUT_QUEUE_SIZE & (OUTPUT_QUEUE_SIZE - 1)) == 0, "OUTPUT_QUEUE_SIZE must be a power of two");
+
+typedef struct {
+    uint8_t keycode;
+    uint8_t mods;
+    uint8_t pause;  // ms to wait after the keystroke, 0 for none.
+} stroke_t;
+
+static stroke_t queue[OUTPUT_QUEUE_SIZE];
+static uint8_t  head   = 0;
+static uint8_t  queued = 0;
+
+static uint8_t depth    = 0;
+static bool    draining = false;  // A hid_batch.h batch is open.
+static bool    paused   = false;  // The last report sent was followed by a pause.
+
+static void step(void);
+static timeout_t next_step = TIMEOUT_INIT(step);
+
+static stroke_t *at(uint8_t i) {
+    return &queue[(head + i) & (OUTPUT_QUEUE_SIZE - 1)];
+}
+
+// Sends the next report, packing as many keystrokes into it as it takes.
+// Returns the ms until the next one, or 0 once the queue is done.
+static uint8_t send_next(void) {
+    if (!draining) {
+        hid_batch_begin();
+        draining = true;
+    }
+    paused = false;
+    if (queued == 0) {
+        hid_batch_end();
+        draining = false;
+        return 0;
+    }
+    uint8_t pause;
+    do {
+        const stroke_t stroke = *at(0);
+        head                  = (head + 1) & (OUTPUT_QUEUE_SIZE - 1);
+        queued--;
+        hid_batch_tap(stroke.keycode, stroke.mods);
+        pause = stroke.pause;
+    } while (pause == 0 && queued > 0 && hid_batch_joins(at(0)->keycode, at(0)->mods));
+    if (pause > 0) {
+        hid_batch_flush();
+        paused = true;
+        return pause;
+    }
+    hid_batch_send();
+    return OUTPUT_QUEUE_INTERVAL;
+}
+
+static void step(void) {
+    const uint8_t delay = send_next();
+    if (delay > 0) {
+        timeout_start(&next_step, delay);
+    }
+}
+
+void output_queue_begin(void) {
+    depth++;
+}
+
+void output_queue_tap(uint8_t keycode, uint8_t mods) {
+    if (queued == OUTPUT_QUEUE_SIZE) {
+        output_queue_flush();
+    }
+    *at(queued) = (stroke_t){.keycode = keycode, .mods = mods};
+    queued++;
+}
+
+void output_queue_char(char c, uint8_t mods) {
+    if ((uint8_t)c >= 128) {
+        return;
+    }
+    const uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)c]);
+    if (pgm_read_byte(&ascii_to_shift_lut[(uint8_t)c / 8]) & (1 << ((uint8_t)c % 8))) {
+        mods |= MOD_BIT(KC_LSFT);
+    }
+    output_queue_tap(keycode, mods);
+}
+
+void output_queue_pause(uint8_t delay_ms) {
+    if (queued > 0) {
+        at(queued - 1)->pause = delay_ms;
+    }
+}
+
+void output_queue_end(void) {
+    if (depth == 0 || --depth > 0) {
+        return;
+    }
+    if (!draining && queued > 0) {
+        step();
+    }
+}
+
+void output_queue_flush(void) {
+    if (!draining && queued == 0) {
+        return;
+    }
+    timeout_cancel(&next_step);
+    uint8_t delay;
+    while ((delay = send_next()) > 0) {
+        // The USB driver paces the reports; only pauses are waited out.
+        if (paused) {
+            wait_ms(delay);
+        }
+    }
+}
+
+bool output_queue_busy(void) {
+    return draining || queued > 0;
+}
@@ -0,0 +1,59 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Macro output that does not hold up the keyboard.
+//
+// Sending a report waits for the host to poll the previous one, so a macro
+// typing several reports in a row keeps the main loop from scanning for as
+// many polling intervals, and longer still with UNICODE_TYPE_DELAY. Here a
+// macro queues its keystrokes and returns:
+//
+//     output_queue_begin();
+//     output_queue_char('o', 0);
+//     output_queue_tap(KC_SPC, 0);
+//     output_queue_end();
+//
+// The first report goes out from output_queue_end(), as a hid_batch.h batch
+// would send it; the next ones are sent one per OUTPUT_QUEUE_INTERVAL ms
+// from features/timeouts.c while the keyboard keeps scanning.
+//
+// Live keys must not overtake the queue: call output_queue_flush() first
+// thing in pre_process_record_user(), for keys as they arrive (before a
+// speculative mod goes out), and in process_record_user(), for keys that
+// waited behind a tap-hold key. It sends what is left there and then, so a
+// key typed during a macro only waits for the output before it.
+//
+// Macros nest: only the outermost output_queue_end() starts the output.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#ifndef OUTPUT_QUEUE_SIZE
+#    define OUTPUT_QUEUE_SIZE 32  // Keystrokes; a power of two.
+#endif
+#ifndef OUTPUT_QUEUE_INTERVAL
+#    define OUTPUT_QUEUE_INTERVAL 1  // ms, the USB polling interval.
+#endif
+
+// Starts queuing a macro.
+void output_queue_begin(void);
+
+// Queues a tap of basic keycode `keycode` with 8-bit mods `mods`.
+void output_queue_tap(uint8_t keycode, uint8_t mods);
+
+// Queues ASCII `c`, adding Shift to `mods` where send_string() would.
+void output_queue_char(char c, uint8_t mods);
+
+// Releases the last keystroke queued in a report of its own and waits
+// `delay_ms` before the next one.
+void output_queue_pause(uint8_t delay_ms);
+
+// Ends the macro, sending its first report if the queue was idle.
+void output_queue_end(void);
+
+// Sends everything queued now.
+void output_queue_flush(void);
+
+// Whether output is queued or being sent.
+bool output_queue_busy(void);
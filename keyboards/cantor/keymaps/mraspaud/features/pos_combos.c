@@ -0,0 +1,271 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Position combo engine. Presses of combo keys are held back until either a
+// combo is complete or the held keys can no longer form one (another key, a
+// release, or POS_COMBO_TERM running out), in which case they are replayed
+// unchanged, as QMK's process_combo.c does.
+
+#include "pos_combos.h"
+#include "timeouts.h"
+#include "keymap_util.h"
+
+#if !defined(REPEAT_KEY_ENABLE) && !defined(COMBO_ENABLE)
+#    error "pos_combos sends combo keycodes through keyrecord_t.keycode: enable REPEAT_KEY."
+#endif
+
+typedef uint32_t combo_set_t;
+
+#define COMBO_BIT(i) ((combo_set_t)1 << (i))
+
+// Combos using each position, and positions of each combo.
+static combo_set_t    combos_at[POS_COMBO_MAX_POSITIONS];
+static position_set_t combo_keys[POS_COMBO_MAX_COMBOS];
+
+static void resolve_buffer(void);
+
+static keyrecord_t    buffer[POS_COMBO_MAX_KEYS];
+static uint8_t        buffer_count = 0;
+static position_set_t buffered     = 0;
+static combo_set_t    candidates   = 0;
+static timeout_t      combo_term   = TIMEOUT_INIT(resolve_buffer);
+
+// The first buffered press when it already went out (pos_combo_eager()): its
+// keycode and position, 0 when it waits in the buffer like the others.
+static uint16_t eager_keycode  = 0;
+static uint8_t  eager_position = 0;
+
+// The typing rhythm: when the last key outside a chord was pressed, the
+// running mean of the intervals between such presses, and the pause before
+// the first buffered key.
+static bool     typed           = false;
+static uint16_t last_press      = 0;
+static uint16_t typing_interval = POS_COMBO_IDLE_INTERVAL;
+static uint16_t buffer_pause    = 0;
+
+// Keys still down from fired combos, and combos whose keycode is still held:
+// a combo is released with the first of its keys to come up.
+static position_set_t held_keys[POS_COMBO_MAX_COMBOS];
+static combo_set_t    held_combos = 0;
+static combo_set_t    down_combos = 0;
+
+static uint8_t position_of(keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return 0;
+    }
+    uint8_t position = pgm_read_byte(&pos_combo_positions[key.row][key.col]);
+    return position < POS_COMBO_MAX_POSITIONS ? position : 0;
+}
+
+static uint8_t pop_index(combo_set_t *set) {
+    uint8_t index = __builtin_ctz(*set);
+    *set &= *set - 1;
+    return index;
+}
+
+void pos_combos_init(void) {
+    memset(combos_at, 0, sizeof(combos_at));
+    memset(combo_keys, 0, sizeof(combo_keys));
+    for (uint8_t i = 0; i < NUM_POS_COMBOS && i < POS_COMBO_MAX_COMBOS; i++) {
+        for (uint8_t k = 0; k < POS_COMBO_MAX_KEYS; k++) {
+            uint8_t position = pgm_read_byte(&pos_combos[i].keys[k]);
+            if (position != 0 && position < POS_COMBO_MAX_POSITIONS) {
+                combos_at[position] |= COMBO_BIT(i);
+                combo_keys[i] |= POSITION_BIT(position);
+            }
+        }
+    }
+    timeout_cancel(&combo_term);
+    buffer_count  = 0;
+    buffered      = 0;
+    candidates    = 0;
+    eager_keycode = 0;
+    held_combos   = 0;
+    down_combos   = 0;
+    memset(held_keys, 0, sizeof(held_keys));
+    typed           = false;
+    typing_interval = POS_COMBO_IDLE_INTERVAL;
+}
+
+uint16_t pos_combo_typing_interval(void) {
+    return typing_interval;
+}
+
+// Takes the press that starts a chord, or a key outside any: returns the
+// pause since the previous one and updates the typing interval,
+// interval += (pause - interval) / 4.
+static uint16_t typing_pause(uint16_t time) {
+    uint16_t pause = POS_COMBO_IDLE_INTERVAL;
+    if (typed && TIMER_DIFF_16(time, last_press) < POS_COMBO_IDLE_INTERVAL) {
+        pause = TIMER_DIFF_16(time, last_press);
+    }
+    typed      = true;
+    last_press = time;
+    typing_interval += ((int16_t)pause - (int16_t)typing_interval) / 4;
+    return pause;
+}
+
+// Whether the pause before the chord is long enough for combo `index`.
+static bool paused_for(uint8_t index) {
+    uint16_t pause = pgm_read_word(&pos_combos[index].pause);
+    if (pgm_read_byte(&pos_combos[index].rolled) && pause > POS_COMBO_PAUSE_INTERVALS * typing_interval) {
+        pause = POS_COMBO_PAUSE_INTERVALS * typing_interval;
+    }
+    return buffer_pause >= pause;
+}
+
+__attribute__((weak)) bool pos_combo_should_trigger(uint8_t index, keyrecord_t *record) {
+    (void)index;
+    (void)record;
+    return true;
+}
+
+__attribute__((weak)) bool pos_combo_eager(uint16_t keycode) {
+    (void)keycode;
+    return false;
+}
+
+__attribute__((weak)) void pos_combo_take_back(uint16_t keycode) {
+    (void)keycode;
+}
+
+static uint16_t combo_keycode(uint8_t index) {
+    return pgm_read_word(&pos_combos[index].keycode);
+}
+
+static void send_combo(uint8_t index, bool pressed) {
+    keyrecord_t record = {.event = MAKE_COMBOEVENT(pressed), .keycode = combo_keycode(index)};
+    action_tapping_process(record);
+}
+
+static void clear_buffer(void) {
+    timeout_cancel(&combo_term);
+    buffer_count  = 0;
+    buffered      = 0;
+    candidates    = 0;
+    eager_keycode = 0;
+}
+
+// Fires the candidate made of exactly the buffered keys, if any, or else
+// replays the buffered presses that have not gone out yet.
+static void resolve_buffer(void) {
+    combo_set_t complete = candidates;
+    while (complete) {
+        uint8_t i = pop_index(&complete);
+        if (combo_keys[i] == buffered && paused_for(i) && pos_combo_should_trigger(i, &buffer[0])) {
+            // An eager key's press went through, so its release must too.
+            held_keys[i] = eager_keycode ? buffered & ~POSITION_BIT(eager_position) : buffered;
+            held_combos |= COMBO_BIT(i);
+            down_combos |= COMBO_BIT(i);
+            if (eager_keycode) {
+                pos_combo_take_back(eager_keycode);
+            }
+            clear_buffer();
+            send_combo(i, true);
+            return;
+        }
+    }
+
+    keyrecord_t records[POS_COMBO_MAX_KEYS];
+    uint8_t     count = buffer_count;
+    uint8_t     first = eager_keycode ? 1 : 0;
+    memcpy(records, buffer, sizeof(keyrecord_t) * count);
+    clear_buffer();
+    for (uint8_t b = first; b < count; b++) {
+        action_tapping_process(records[b]);
+    }
+}
+
+// Swallows the release of a key that is part of a fired combo.
+static bool release_held_key(uint8_t position) {
+    combo_set_t combos = combos_at[position] & held_combos;
+    while (combos) {
+        uint8_t i = pop_index(&combos);
+        if (!(held_keys[i] & POSITION_BIT(position))) {
+            continue;
+        }
+        if (down_combos & COMBO_BIT(i)) {
+            down_combos &= ~COMBO_BIT(i);
+            send_combo(i, false);
+        }
+        held_keys[i] &= ~POSITION_BIT(position);
+        if (held_keys[i] == 0) {
+            held_combos &= ~COMBO_BIT(i);
+        }
+        return true;
+    }
+    return false;
+}
+
+static bool incomplete_candidate_left(void) {
+    combo_set_t left = candidates;
+    while (left) {
+        if (combo_keys[pop_index(&left)] != buffered) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static combo_set_t active_on_layer(combo_set_t combos) {
+    const layer_state_t layer  = LAYER_BIT(get_highest_layer(layer_state | default_layer_state));
+    combo_set_t         active = 0;
+    while (combos) {
+        uint8_t i = pop_index(&combos);
+        if (pgm_read_dword(&pos_combos[i].layers) & layer) {
+            active |= COMBO_BIT(i);
+        }
+    }
+    return active;
+}
+
+bool pos_combos_holding(void) {
+    return buffer_count > 0;
+}
+
+bool process_pos_combos(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.type != KEY_EVENT) {
+        return true;
+    }
+    const uint8_t position = position_of(record->event.key);
+
+    if (!record->event.pressed) {
+        if (position == 0) {
+            return true;
+        }
+        if (buffered & POSITION_BIT(position)) {
+            resolve_buffer();
+        }
+        return !release_held_key(position);
+    }
+
+    if (buffer_count > 0 && !(candidates & combos_at[position])) {
+        resolve_buffer();
+    }
+    bool eager = false;
+    if (buffer_count == 0) {
+        const uint16_t pause = typing_pause(record->event.time);
+        candidates           = active_on_layer(combos_at[position]);
+        if (!candidates) {
+            return true;
+        }
+        buffer_pause = pause;
+        timeout_start(&combo_term, POS_COMBO_TERM);
+        // A key that can be taken back goes out now; the combo, if it comes,
+        // takes it back.
+        if (pos_combo_eager(keycode)) {
+            eager          = true;
+            eager_keycode  = keycode;
+            eager_position = position;
+        }
+    } else {
+        candidates &= combos_at[position];
+    }
+
+    buffer[buffer_count++] = *record;
+    buffered |= POSITION_BIT(position);
+    if (!incomplete_candidate_left()) {
+        resolve_buffer();
+    }
+    return eager;
+}
@@ -0,0 +1,105 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Combos defined by key position instead of keycode.
+//
+// A keycode combo only matches on layers where its keys carry those exact
+// keycodes, so the same pair of keys needs one combo per layer that changes
+// them. Here a combo names the positions of its keys and the layers it is
+// active on, so one entry covers them all.
+//
+// Positions are small numbers (1 to POS_COMBO_MAX_POSITIONS - 1) that the
+// keymap assigns to matrix keys through pos_combo_positions, normally written
+// with the LAYOUT macro; 0 marks keys that are in no combo. At init, every
+// position gets the set of combos using it, so a key event only ever looks at
+// the combos containing that key, whatever the size of the table.
+//
+// Usage in keymap.c:
+//
+//     const uint8_t pos_combo_positions[MATRIX_ROWS][MATRIX_COLS] PROGMEM = LAYOUT(...);
+//     const pos_combo_t pos_combos[] PROGMEM = {
+//         POS_COMBO(KC_TAB, LAYER_MASK, P_C, P_T),
+//     };
+//     uint8_t NUM_POS_COMBOS = ARRAY_SIZE(pos_combos);
+//
+// A combo whose keys are also typed in quick succession as text can ask for
+// a pause before it: POS_COMBO_PAUSED(KC_BSPC, LAYER_MASK, 500, P_SLSH, P_J)
+// only fires if its first key comes `pause` ms after the key pressed before
+// it. POS_COMBO_ROLLED(KC_ENT, LAYER_MASK, 150, P_A, P_I) makes the pause
+// follow the typing rhythm instead: `pause` ms, or POS_COMBO_PAUSE_INTERVALS
+// times the current typing interval if that is shorter, so that in a burst
+// of prose the combo's keys type as letters, and after a short pause the
+// combo fires with no delay. The typing interval is a running mean of the
+// time between presses, leaving out the later keys of a chord. A combo that
+// must not fire on keys typed in a row (~/ on a symbol layer) keeps the
+// fixed pause: fast typing is when it matters most.
+//
+// A key that types on the press and can erase it again, such as an eager tap
+// dance, need not be held back at all: when pos_combo_eager() allows its
+// keycode, its press goes out at once as the first key of a chord, and if
+// the combo follows, pos_combo_take_back() erases what it typed before the
+// combo fires. Its release is left to it. Other keys are held back as usual.
+//
+// Call pos_combos_init() from keyboard_post_init_user() and
+// process_pos_combos() first thing in pre_process_record_user(). The combo
+// keycode is sent as a COMBO_EVENT record, which needs keyrecord_t.keycode
+// (REPEAT_KEY_ENABLE); QMK's own COMBO_ENABLE should be off. POS_COMBO_TERM
+// runs on features/timeouts.c.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Combos are tracked in 32-bit sets.
+#define POS_COMBO_MAX_COMBOS 32
+// Positions are tracked in 64-bit sets; position 0 means "not in a combo".
+#define POS_COMBO_MAX_POSITIONS 64
+#define POS_COMBO_MAX_KEYS 4
+
+#ifndef POS_COMBO_TERM
+#    define POS_COMBO_TERM 50
+#endif
+#ifndef POS_COMBO_PAUSE_INTERVALS
+#    define POS_COMBO_PAUSE_INTERVALS 2
+#endif
+// Longer gaps between presses count as this much in the typing interval.
+#ifndef POS_COMBO_IDLE_INTERVAL
+#    define POS_COMBO_IDLE_INTERVAL 1000
+#endif
+
+typedef struct {
+    uint8_t       keys[POS_COMBO_MAX_KEYS];  // Positions, 0 for unused slots.
+    uint16_t      keycode;
+    uint16_t      pause;   // Pause needed before the first key, in ms (0: none).
+    bool          rolled;  // Shorter pauses do in fast typing.
+    layer_state_t layers;  // Layers the combo is active on (highest active layer).
+} pos_combo_t;
+
+#define POS_COMBO(kc, layer_mask, ...) {.keys = {__VA_ARGS__}, .keycode = (kc), .layers = (layer_mask)}
+#define POS_COMBO_PAUSED(kc, layer_mask, pause_ms, ...) {.keys = {__VA_ARGS__}, .keycode = (kc), .pause = (pause_ms), .layers = (layer_mask)}
+#define POS_COMBO_ROLLED(kc, layer_mask, pause_ms, ...) {.keys = {__VA_ARGS__}, .keycode = (kc), .pause = (pause_ms), .rolled = true, .layers = (layer_mask)}
+
+extern const uint8_t     pos_combo_positions[MATRIX_ROWS][MATRIX_COLS];
+extern const pos_combo_t pos_combos[];
+extern uint8_t           NUM_POS_COMBOS;
+
+// Builds the position index and clears any pending combo.
+void pos_combos_init(void);
+
+// Returns false when the event was taken by the combo engine.
+bool process_pos_combos(uint16_t keycode, keyrecord_t *record);
+
+// Whether presses are held back, waiting for the rest of a combo.
+bool pos_combos_holding(void);
+
+// Called with the first buffered record before combo `index` fires; returning
+// false types the buffered keys instead.
+bool pos_combo_should_trigger(uint8_t index, keyrecord_t *record);
+
+// Whether a press of `keycode` types something pos_combo_take_back() can
+// erase, so that it need not wait for the rest of its combos.
+bool pos_combo_eager(uint16_t keycode);
+void pos_combo_take_back(uint16_t keycode);
+
+// The running mean of the time between presses, in ms.
+uint16_t pos_combo_typing_interval(void);
@@ -0,0 +1,134 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "profile.h"
+
+#include <ch.h>
+
+#define TICKS_PER_US (STM32_SYSCLK / 1000000U)
+
+static profile_stats_t window[PROFILE_COUNTERS];
+static profile_stats_t reported[PROFILE_COUNTERS];
+static uint32_t        window_start;
+static uint32_t        reported_ms;
+
+static uint32_t last_scan;
+static bool     scanned = false;
+static uint32_t hooks_since_scan;  // Ticks in outermost hooks since the last scan.
+
+// Entry times of the hooks running, outermost first.
+static uint32_t entered[PROFILE_MAX_DEPTH];
+static uint8_t  depth = 0;
+
+static uint32_t ticks(void) {
+    return chSysGetRealtimeCounterX();
+}
+
+static void add(uint8_t counter, uint32_t value) {
+    profile_stats_t *stats = &window[counter];
+    if (stats->count == 0 || value < stats->min) {
+        stats->min = value;
+    }
+    if (value > stats->max) {
+        stats->max = value;
+    }
+    stats->count++;
+    stats->total += value;
+}
+
+static void close_window(uint32_t elapsed) {
+    memcpy(reported, window, sizeof(reported));
+    memset(window, 0, sizeof(window));
+    reported_ms = elapsed;
+#ifdef CONSOLE_ENABLE
+    if (reported[PROFILE_PRE_PROCESS].count > 0) {
+        profile_print();
+    }
+#endif
+}
+
+void profile_init(void) {
+    memset(window, 0, sizeof(window));
+    memset(reported, 0, sizeof(reported));
+    reported_ms      = 0;
+    window_start     = timer_read32();
+    scanned          = false;
+    hooks_since_scan = 0;
+    depth            = 0;
+}
+
+void profile_scan(void) {
+    const uint32_t now = ticks();
+    if (scanned) {
+        add(PROFILE_SCAN, now - last_scan);
+        add(PROFILE_HOOKS, hooks_since_scan);
+    }
+    last_scan        = now;
+    scanned          = true;
+    hooks_since_scan = 0;
+
+    const uint32_t elapsed = timer_elapsed32(window_start);
+    if (elapsed >= PROFILE_WINDOW) {
+        window_start += elapsed;
+        close_window(elapsed);
+        // Printing took time: leave it out of the next scan.
+        scanned = false;
+    }
+}
+
+void profile_enter(uint8_t counter) {
+    if (depth < PROFILE_MAX_DEPTH) {
+        entered[depth] = ticks();
+    }
+    depth++;
+}
+
+void profile_exit(uint8_t counter) {
+    if (depth == 0) {
+        return;
+    }
+    depth--;
+    if (depth >= PROFILE_MAX_DEPTH) {
+        return;
+    }
+    const uint32_t spent = ticks() - entered[depth];
+    add(counter, spent);
+    if (depth == 0) {
+        hooks_since_scan += spent;
+    }
+}
+
+const profile_stats_t *profile_stats(uint8_t counter) {
+    return counter < PROFILE_COUNTERS ? &reported[counter] : NULL;
+}
+
+uint32_t profile_scan_rate(void) {
+    return reported_ms > 0 ? (uint64_t)reported[PROFILE_SCAN].count * 1000 / reported_ms : 0;
+}
+
+static const char *const counter_names[PROFILE_COUNTERS] = {"scan", "hooks", "pre_process", "process", "caps_word", "flow_tap"};
+
+// Prints `ticks` in µs with one decimal.
+static void print_us(const char *label, uint64_t ticks) {
+    const uint32_t tenths = ticks * 10 / TICKS_PER_US;
+    uprintf(" %s %lu.%lu", label, (unsigned long)(tenths / 10), (unsigned long)(tenths % 10));
+}
+
+void profile_print(void) {
+    const profile_stats_t *scan  = &reported[PROFILE_SCAN];
+    const profile_stats_t *hooks = &reported[PROFILE_HOOKS];
+    // Per mille of the time between scans spent in hooks.
+    const uint32_t busy = scan->total > 0 ? hooks->total * 1000 / scan->total : 0;
+    uprintf("profile scans %lu/s, %lu.%lu%% in hooks\n", (unsigned long)profile_scan_rate(), (unsigned long)(busy / 10), (unsigned long)(busy % 10));
+    for (uint8_t counter = 0; counter < PROFILE_COUNTERS; counter++) {
+        const profile_stats_t *stats = &reported[counter];
+        if (stats->count == 0) {
+            continue;
+        }
+        uprintf("profile %s %lu", counter_names[counter], (unsigned long)stats->count);
+        print_us("min", stats->min);
+        print_us("avg", stats->total / stats->count);
+        print_us("max", stats->max);
+        uprintf(" us\n");
+    }
+}
@@ -0,0 +1,98 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Scan rate and the cost of the keymap's hooks, for instrumented builds.
+//
+// matrix_scan_user() counts scans and times the gap between two of them,
+// and every hook of the keymap is timed with the Cortex-M cycle counter from
+// entry to exit:
+//
+//     scan         from one scan to the next
+//     hooks        time spent in all the hooks below, per scan
+//     pre_process  pre_process_record_user(): the position combos
+//     process      process_record_user()
+//     caps_word    caps_word_press_user()
+//     flow_tap     get_flow_tap_term()
+//
+// A hook called from another one (a combo firing process_record_user from
+// pre_process_record_user) counts for both, but only once in "hooks".
+// The counters cover PROFILE_WINDOW ms at a time. When a window closes it
+// becomes the one reported, and with CONSOLE_ENABLE, if any key was
+// processed in it, it is printed:
+//
+//     profile scans 4318/s, 0.4% in hooks
+//     profile scan 4318 min 224.0 avg 231.6 max 1207.3 us
+//     profile process 12 min 2.1 avg 9.8 max 61.0 us
+//     ...
+//
+// "scan" max against avg is the headroom a burst of typing leaves.
+//
+// Wrap each hook's body in keymap.c:
+//
+//     bool caps_word_press_user(uint16_t keycode) {
+//         profile_enter(PROFILE_CAPS_WORD);
+//         ...
+//         profile_exit(PROFILE_CAPS_WORD);
+//         return result;
+//     }
+//
+// and call profile_scan() from matrix_scan_user(). Build with
+// PROFILE_ENABLE=yes (qmk compile -e PROFILE_ENABLE=yes). Without it the
+// hooks are empty inline functions and nothing is compiled in.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#ifndef PROFILE_WINDOW
+#    define PROFILE_WINDOW 1000
+#endif
+#define PROFILE_MAX_DEPTH 4
+
+enum profile_counter {
+    PROFILE_SCAN,
+    PROFILE_HOOKS,
+    PROFILE_PRE_PROCESS,
+    PROFILE_PROCESS,
+    PROFILE_CAPS_WORD,
+    PROFILE_FLOW_TAP,
+    PROFILE_COUNTERS,
+};
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;  // Cycle counter ticks.
+    uint32_t max;
+    uint64_t total;
+} profile_stats_t;
+
+#ifdef PROFILE_ENABLE
+
+void profile_init(void);
+
+// Call from matrix_scan_user().
+void profile_scan(void);
+
+// Call first and last thing in the hook timed by `counter`.
+void profile_enter(uint8_t counter);
+void profile_exit(uint8_t counter);
+
+// The last complete window.
+const profile_stats_t *profile_stats(uint8_t counter);
+uint32_t               profile_scan_rate(void);  // Scans per second.
+
+// Prints the last complete window.
+void profile_print(void);
+
+#else
+
+static inline void profile_init(void) {}
+static inline void profile_scan(void) {}
+static inline void profile_enter(uint8_t counter) {
+    (void)counter;
+}
+static inline void profile_exit(uint8_t counter) {
+    (void)counter;
+}
+
+#endif
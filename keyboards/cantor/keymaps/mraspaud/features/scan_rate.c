@@ -0,0 +1,56 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "scan_rate.h"
+
+#include <ch.h>
+
+static uint8_t  keys_down = 0;
+static uint32_t last_change;
+
+void scan_rate_init(void) {
+    keys_down   = 0;
+    last_change = timer_read32();
+}
+
+void scan_rate_record(keyrecord_t *record) {
+    if (record->event.type != KEY_EVENT) {
+        return;
+    }
+    if (record->event.pressed) {
+        keys_down++;
+    } else if (keys_down > 0) {
+        keys_down--;
+    }
+    last_change = timer_read32();
+}
+
+scan_rate_mode_t scan_rate_mode(void) {
+    if (keys_down > 0) {
+        // A held key is a tap-hold key to time, or a release to catch.
+        return SCAN_RATE_BURST;
+    }
+    const uint32_t elapsed = timer_elapsed32(last_change);
+    if (elapsed < SCAN_RATE_TAIL) {
+        return SCAN_RATE_BURST;
+    }
+    return elapsed < SCAN_RATE_IDLE_TIMEOUT ? SCAN_RATE_ACTIVE : SCAN_RATE_IDLE;
+}
+
+uint32_t scan_rate_pause(void) {
+    switch (scan_rate_mode()) {
+        case SCAN_RATE_ACTIVE:
+            return SCAN_RATE_ACTIVE_PAUSE;
+        case SCAN_RATE_IDLE:
+            return SCAN_RATE_IDLE_PAUSE;
+        default:
+            return 0;
+    }
+}
+
+void scan_rate_task(void) {
+    const uint32_t pause = scan_rate_pause();
+    if (pause > 0) {
+        chThdSleepMicroseconds(pause);
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Matrix scan rate following the typing.
+//
+// QMK scans the matrix as fast as its main loop goes, whether keys are being
+// typed or the board has been left alone for hours, and with USB suspend
+// disabled nothing slows it down. Here the loop pauses between scans, for a
+// time set by how recently a key changed:
+//
+//     burst   no pause     keys held, or SCAN_RATE_TAIL ms since a change
+//     active  SCAN_RATE_ACTIVE_PAUSE us, until SCAN_RATE_IDLE_TIMEOUT ms
+//     idle    SCAN_RATE_IDLE_PAUSE us
+//
+// The first change seen, even at the idle rate, goes back to a burst from the
+// same loop iteration on, so a typing burst is scanned at the full rate from
+// its first key; only that key waits up to one idle pause to be seen. While
+// paused the main thread sleeps, leaving the CPU to ChibiOS's idle thread.
+//
+// Feed it every key event and run it once per loop:
+//
+//     bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+//         scan_rate_record(record);
+//         ...
+//     }
+//
+//     void housekeeping_task_user(void) {
+//         scan_rate_task();
+//     }
+//
+// scan_rate_mode() and scan_rate_pause() only read the state, so the
+// schedule can be checked against timelines in the simulator
+// (sim/bench/scan_rate.c).
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#ifndef SCAN_RATE_TAIL
+#    define SCAN_RATE_TAIL 250
+#endif
+#ifndef SCAN_RATE_IDLE_TIMEOUT
+#    define SCAN_RATE_IDLE_TIMEOUT 5000
+#endif
+#ifndef SCAN_RATE_ACTIVE_PAUSE
+#    define SCAN_RATE_ACTIVE_PAUSE 1000
+#endif
+#ifndef SCAN_RATE_IDLE_PAUSE
+#    define SCAN_RATE_IDLE_PAUSE 5000
+#endif
+
+typedef enum {
+    SCAN_RATE_BURST,
+    SCAN_RATE_ACTIVE,
+    SCAN_RATE_IDLE,
+} scan_rate_mode_t;
+
+void scan_rate_init(void);
+
+// Notes a key change. Call from pre_process_record_user().
+void scan_rate_record(keyrecord_t *record);
+
+// The mode at the current time.
+scan_rate_mode_t scan_rate_mode(void);
+
+// The pause before the next scan, in microseconds.
+uint32_t scan_rate_pause(void);
+
+// Pauses the main loop as scan_rate_pause() says. Call from
+// housekeeping_task_user().
+void scan_rate_task(void);
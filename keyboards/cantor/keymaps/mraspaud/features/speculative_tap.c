@@ -0,0 +1,92 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "speculative_tap.h"
+#include "pos_combos.h"
+#include "keymap_util.h"
+
+_Static_assert(MATRIX_ROWS * MATRIX_COLS <= 64, "pending keys are kept in a 64-bit set");
+
+// Tap-hold keys pressed and not yet settled, wherever they wait: in QMK's
+// tapping code or in the combo buffer.
+static position_set_t pending = 0;
+
+// The layer-tap whose tap went out on the press, and whether it settled as
+// a tap, so that its release is swallowed too.
+static bool     speculating = false;
+static bool     tapped      = false;
+static keypos_t speculated;
+
+static bool is_tap_hold(uint16_t keycode) {
+    return IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode);
+}
+
+// Erases the tap.
+static void take_back_tap(void) {
+    take_back();
+    speculating = false;
+}
+
+static bool safe_to_type(void) {
+    if (speculating || pending || pos_combos_holding()) {
+        return false;
+    }
+    if ((get_mods() | get_weak_mods() | get_oneshot_mods()) & ~MOD_MASK_SHIFT) {
+        return false;
+    }
+#ifdef CAPS_WORD_ENABLE
+    if (is_caps_word_on()) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+void pre_process_speculative_tap(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.type != KEY_EVENT) {
+        return;
+    }
+    if (!record->event.pressed) {
+        // A release settles its key, whatever held the press back.
+        pending &= ~POSITION_BIT(MATRIX_INDEX(record->event.key));
+        return;
+    }
+    if (!is_tap_hold(keycode)) {
+        return;
+    }
+    if (IS_QK_LAYER_TAP(keycode) && safe_to_type() && get_speculative_tap(keycode, record)) {
+        tap_code(QK_LAYER_TAP_GET_TAP_KEYCODE(keycode));
+        speculating = true;
+        tapped      = false;
+        speculated  = record->event.key;
+    }
+    pending |= POSITION_BIT(MATRIX_INDEX(record->event.key));
+}
+
+bool process_speculative_tap(const key_event_t *event, keyrecord_t *record) {
+    if (!event->pressed) {
+        if (speculating && tapped && record->event.type == KEY_EVENT && KEYEQ(record->event.key, speculated)) {
+            speculating = false;
+            return false;
+        }
+        return true;
+    }
+    if (record->event.type == KEY_EVENT) {
+        pending &= ~POSITION_BIT(MATRIX_INDEX(record->event.key));
+    }
+    if (!speculating || tapped) {
+        return true;
+    }
+    if (record->event.type == KEY_EVENT && KEYEQ(record->event.key, speculated)) {
+        if (record->tap.count > 0) {
+            tapped = true;
+            return false;
+        }
+        take_back_tap();
+        return true;
+    }
+    // Nothing pressed after the speculative key settles before it: a press
+    // coming first is the combo that took it.
+    take_back_tap();
+    return true;
+}
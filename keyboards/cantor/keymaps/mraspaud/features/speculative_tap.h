@@ -0,0 +1,42 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Layer-taps that type their tap on the press.
+//
+// A layer-tap key only types once it is released, or once the key after it
+// settles it as a tap, so its character always comes late. SPECULATIVE_HOLD
+// does the opposite for mod-taps, holding the mod from the press. Here a
+// layer-tap press that get_speculative_tap() allows types its tap keycode
+// right away; when the key settles as a tap nothing more is sent, and when
+// it settles as a hold, or goes into a combo, the character is taken back
+// with Backspace (sent without the mods held) before the layer or the combo
+// comes on:
+//
+//     bool get_speculative_tap(uint16_t keycode, keyrecord_t *record) {
+//         // Space and R straight after a letter: typing prose.
+//         return (keycode == LT_SPC || keycode == LT_R) && key_history_word_length() > 0;
+//     }
+//
+// The tap is typed only if it cannot overtake or pick up something meant
+// otherwise: no other tap-hold key may be waiting to settle, nor any press
+// in the position combo buffer, and no mods but Shift may be on, nor Caps
+// Word.
+//
+// Call pre_process_speculative_tap() from pre_process_record_user() before
+// process_pos_combos(), and register process_speculative_tap() early in
+// key_handlers[] (key_event.h) for every keycode: any press may be the combo
+// that took the key.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "key_event.h"
+
+// Whether a press of layer-tap `keycode` may type its tap right away.
+bool get_speculative_tap(uint16_t keycode, keyrecord_t *record);
+
+// Types the tap of an allowed layer-tap press.
+void pre_process_speculative_tap(uint16_t keycode, keyrecord_t *record);
+
+// Returns false for the tap already typed; takes it back otherwise.
+bool process_speculative_tap(const key_event_t *event, keyrecord_t *record);
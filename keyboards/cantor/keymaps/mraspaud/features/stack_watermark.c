@@ -0,0 +1,143 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "stack_watermark.h"
+
+#include <ch.h>
+
+// ChibiOS's startup code fills both stacks with this when CRT0_INIT_STACKS
+// is on, as it is by default.
+#define PATTERN 0x55555555U
+
+// Words left unpainted under the caller's frame, for the painting loop's own.
+#define MARGIN_WORDS 16
+
+// From the linker script: the process stack runs the main thread, the main
+// stack the interrupts. Both grow down from their end.
+extern uint32_t __process_stack_base__[], __process_stack_end__[];
+extern uint32_t __main_stack_base__[], __main_stack_end__[];
+
+static uint32_t peak[STACK_WATERMARK_COUNTERS];
+static bool     raised = false;  // A peak rose since the last print.
+static uint32_t printed_at;
+
+// Deepest word reached by each hook running, outermost first.
+static uint32_t *reached[STACK_WATERMARK_MAX_DEPTH];
+static uint8_t   counters[STACK_WATERMARK_MAX_DEPTH];
+static uint8_t   depth = 0;
+
+// The lowest word of [base, end) no longer holding the pattern; `end` if none.
+static uint32_t *deepest(uint32_t *base, uint32_t *end) {
+    uint32_t *word = base;
+    while (word < end && *word == PATTERN) {
+        word++;
+    }
+    return word;
+}
+
+static uint32_t bytes_used(uint32_t *deepest_word, uint32_t *end) {
+    return (uintptr_t)end - (uintptr_t)deepest_word;
+}
+
+// Paints from `from` up to just under the caller's frame.
+static __attribute__((noinline)) void paint(uint32_t *from) {
+    uint32_t *top = (uint32_t *)__builtin_frame_address(0) - MARGIN_WORDS;
+    for (uint32_t *word = from; word < top; word++) {
+        *word = PATTERN;
+    }
+}
+
+static void charge(uint8_t counter, uint32_t *deepest_word) {
+    const uint32_t used = bytes_used(deepest_word, __process_stack_end__);
+    if (used > peak[counter]) {
+        peak[counter] = used;
+        raised        = true;
+    }
+}
+
+// Charges the stack used since the last paint to the hooks running, or to
+// QMK outside them, and returns the deepest word it reached.
+static uint32_t *collect(void) {
+    uint32_t *word = deepest(__process_stack_base__, __process_stack_end__);
+    if (depth == 0) {
+        charge(STACK_WATERMARK_QMK, word);
+    }
+    for (uint8_t i = 0; i < depth && i < STACK_WATERMARK_MAX_DEPTH; i++) {
+        if (word < reached[i]) {
+            reached[i] = word;
+        }
+    }
+    return word;
+}
+
+void stack_watermark_init(void) {
+    memset(peak, 0, sizeof(peak));
+    depth = 0;
+    // What booting took is QMK's.
+    paint(collect());
+    raised     = false;
+    printed_at = timer_read32();
+}
+
+void stack_watermark_scan(void) {
+    collect();
+#ifdef CONSOLE_ENABLE
+    if (raised && timer_elapsed32(printed_at) >= STACK_WATERMARK_WINDOW) {
+        stack_watermark_print();
+        raised     = false;
+        printed_at = timer_read32();
+    }
+#endif
+}
+
+void stack_watermark_enter(uint8_t counter) {
+    uint32_t *word = collect();
+    if (depth < STACK_WATERMARK_MAX_DEPTH) {
+        reached[depth]  = __process_stack_end__;
+        counters[depth] = counter;
+    }
+    depth++;
+    // Only what this hook reaches from here on counts for it.
+    paint(word);
+}
+
+void stack_watermark_exit(uint8_t counter) {
+    if (depth == 0) {
+        return;
+    }
+    uint32_t *word = collect();
+    depth--;
+    if (depth < STACK_WATERMARK_MAX_DEPTH) {
+        charge(counters[depth], reached[depth]);
+    }
+    if (depth == 0) {
+        // Leave QMK a clean stack, so that it is not charged for the hook.
+        paint(word);
+    }
+}
+
+uint32_t stack_watermark_peak(uint8_t counter) {
+    return counter < STACK_WATERMARK_COUNTERS ? peak[counter] : 0;
+}
+
+static const char *const counter_names[STACK_WATERMARK_COUNTERS] = {"process", "unicode", "combos", "timeouts", "qmk"};
+
+void stack_watermark_print(void) {
+    uint32_t main_peak = 0;
+    for (uint8_t counter = 0; counter < STACK_WATERMARK_COUNTERS; counter++) {
+        if (peak[counter] > main_peak) {
+            main_peak = peak[counter];
+        }
+    }
+    uprintf("stack main %lu of %lu bytes\n", (unsigned long)main_peak, (unsigned long)bytes_used(__process_stack_base__, __process_stack_end__));
+    for (uint8_t counter = 0; counter < STACK_WATERMARK_COUNTERS; counter++) {
+        if (peak[counter] > 0) {
+            uprintf("stack %s %lu\n", counter_names[counter], (unsigned long)peak[counter]);
+        }
+    }
+    const uint32_t irq = bytes_used(deepest(__main_stack_base__, __main_stack_end__), __main_stack_end__);
+    uprintf("stack irq %lu of %lu bytes\n", (unsigned long)irq, (unsigned long)bytes_used(__main_stack_base__, __main_stack_end__));
+#if defined(CH_CFG_USE_MEMCORE) && CH_CFG_USE_MEMCORE == TRUE
+    uprintf("stack ram free %lu bytes\n", (unsigned long)chCoreGetStatusX());
+#endif
+}
@@ -0,0 +1,97 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Stack high-water marks of the keymap's hooks, for instrumented builds.
+//
+// QMK runs in ChibiOS's main thread, on the process stack. At boot the free
+// part of that stack is painted with a pattern; every hook entry below looks
+// for the deepest word no longer holding it, charges that depth to the hooks
+// running, and paints again below itself, so that each hook gets the deepest
+// point reached while it ran, however deep the code under it went:
+//
+//     process   process_record_user()
+//     unicode   send_unicode_sequence()
+//     combos    process_pos_combos(), with the combo actions it fires
+//     timeouts  the timeouts run from deferred exec: combo terms, tap
+//               dances, adaptive terms
+//     qmk       everything outside these hooks
+//
+// Depths are in bytes from the top of the stack, the frames of QMK above the
+// hook included: what matters is how close they come to the bottom. The
+// interrupt stack, painted by ChibiOS's startup code, is read the same way,
+// and so is the RAM left between the static data and the stacks, for
+// features yet to come.
+//
+// With CONSOLE_ENABLE, a new peak is printed at most once per
+// STACK_WATERMARK_WINDOW ms:
+//
+//     stack main 1124 of 2048 bytes
+//     stack process 1124
+//     stack unicode 968
+//     ...
+//     stack irq 184 of 1024 bytes
+//     stack ram free 3512 bytes
+//
+// Wrap each hook's body:
+//
+//     bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+//         stack_watermark_enter(STACK_WATERMARK_PROCESS);
+//         ...
+//         stack_watermark_exit(STACK_WATERMARK_PROCESS);
+//         return result;
+//     }
+//
+// call stack_watermark_init() first in keyboard_post_init_user() and
+// stack_watermark_scan() from matrix_scan_user(). Build with
+// STACK_WATERMARK_ENABLE=yes (qmk compile -e STACK_WATERMARK_ENABLE=yes);
+// without it the hooks are empty inline functions. The simulator has no
+// stack of its own to measure and always builds without.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#ifndef STACK_WATERMARK_WINDOW
+#    define STACK_WATERMARK_WINDOW 1000
+#endif
+#define STACK_WATERMARK_MAX_DEPTH 4
+
+enum stack_watermark_counter {
+    STACK_WATERMARK_PROCESS,
+    STACK_WATERMARK_UNICODE,
+    STACK_WATERMARK_COMBOS,
+    STACK_WATERMARK_TIMEOUTS,
+    STACK_WATERMARK_QMK,
+    STACK_WATERMARK_COUNTERS,
+};
+
+#ifdef STACK_WATERMARK_ENABLE
+
+// Paints the free stack. Call first in keyboard_post_init_user().
+void stack_watermark_init(void);
+
+// Call from matrix_scan_user().
+void stack_watermark_scan(void);
+
+// Call first and last thing in the hook measured by `counter`.
+void stack_watermark_enter(uint8_t counter);
+void stack_watermark_exit(uint8_t counter);
+
+// Deepest point reached under `counter` since boot, in bytes.
+uint32_t stack_watermark_peak(uint8_t counter);
+
+// Prints the peaks, the stack sizes and the free RAM.
+void stack_watermark_print(void);
+
+#else
+
+static inline void stack_watermark_init(void) {}
+static inline void stack_watermark_scan(void) {}
+static inline void stack_watermark_enter(uint8_t counter) {
+    (void)counter;
+}
+static inline void stack_watermark_exit(uint8_t counter) {
+    (void)counter;
+}
+
+#endif
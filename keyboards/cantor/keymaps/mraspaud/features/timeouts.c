@@ -0,0 +1,108 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "timeouts.h"
+#include "stack_watermark.h"
+
+static timeout_t     *pending = NULL;  // Sorted by deadline.
+static deferred_token token   = INVALID_DEFERRED_TOKEN;
+static bool           running = false;
+
+static bool before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static uint32_t delay_until(uint32_t deadline, uint32_t now) {
+    return before(now, deadline) ? deadline - now : 1;
+}
+
+static uint32_t run_timeouts(uint32_t trigger_time, void *cb_arg) {
+    (void)cb_arg;
+    stack_watermark_enter(STACK_WATERMARK_TIMEOUTS);
+    const uint32_t now = timer_read32();
+    running            = true;
+    while (pending != NULL && !before(now, pending->deadline)) {
+        timeout_t *timeout = pending;
+        pending            = timeout->next;
+        timeout->next      = NULL;
+        timeout->pending   = false;
+        if (timeout->callback != NULL) {
+            timeout->callback();
+        }
+    }
+    running = false;
+    stack_watermark_exit(STACK_WATERMARK_TIMEOUTS);
+    if (pending == NULL) {
+        token = INVALID_DEFERRED_TOKEN;
+        return 0;
+    }
+    // The executor adds the returned delay to its trigger time.
+    return delay_until(pending->deadline, trigger_time);
+}
+
+// Points the executor at the earliest deadline. While the timeouts run, the
+// executor picks it up from their return value instead.
+static void arm(void) {
+    if (running) {
+        return;
+    }
+    if (pending == NULL) {
+        if (token != INVALID_DEFERRED_TOKEN) {
+            cancel_deferred_exec(token);
+            token = INVALID_DEFERRED_TOKEN;
+        }
+        return;
+    }
+    const uint32_t delay = delay_until(pending->deadline, timer_read32());
+    if (token == INVALID_DEFERRED_TOKEN || !extend_deferred_exec(token, delay)) {
+        token = defer_exec(delay, run_timeouts, NULL);
+    }
+}
+
+static void unlink(timeout_t *timeout) {
+    for (timeout_t **link = &pending; *link != NULL; link = &(*link)->next) {
+        if (*link == timeout) {
+            *link = timeout->next;
+            break;
+        }
+    }
+    timeout->next    = NULL;
+    timeout->pending = false;
+}
+
+void timeouts_init(void) {
+    while (pending != NULL) {
+        unlink(pending);
+    }
+    arm();
+}
+
+void timeout_start(timeout_t *timeout, uint32_t delay_ms) {
+    const bool was_first = pending == timeout;
+    if (timeout->pending) {
+        unlink(timeout);
+    }
+    timeout->deadline = timer_read32() + delay_ms;
+    timeout->pending  = true;
+
+    timeout_t **link = &pending;
+    while (*link != NULL && !before(timeout->deadline, (*link)->deadline)) {
+        link = &(*link)->next;
+    }
+    timeout->next = *link;
+    *link         = timeout;
+    if (pending == timeout || was_first) {
+        arm();
+    }
+}
+
+void timeout_cancel(timeout_t *timeout) {
+    if (!timeout->pending) {
+        return;
+    }
+    const bool was_first = pending == timeout;
+    unlink(timeout);
+    if (was_first) {
+        arm();
+    }
+}
@@ -0,0 +1,44 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Timeouts for keymap features, all run from one deferred executor.
+//
+// A feature owns a timeout_t and starts it when a window opens; the callback
+// runs once the time is up, even if no key is pressed, and timeout_pending()
+// tells whether the window is still open. Nothing is checked on key events:
+// pending timeouts are kept sorted by deadline and the executor is armed for
+// the earliest one only.
+//
+//     static void window_closed(void) { ... }
+//     static timeout_t window = TIMEOUT_INIT(window_closed);
+//
+//     timeout_start(&window, 1000);
+//     if (timeout_pending(&window)) { ... }
+//
+// Needs DEFERRED_EXEC_ENABLE.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+typedef struct timeout {
+    struct timeout *next;
+    uint32_t        deadline;
+    void (*callback)(void);  // May be NULL.
+    bool pending;
+} timeout_t;
+
+#define TIMEOUT_INIT(cb) {.callback = (cb)}
+
+// Drops every pending timeout.
+void timeouts_init(void);
+
+// (Re)starts `timeout` to expire `delay_ms` from now.
+void timeout_start(timeout_t *timeout, uint32_t delay_ms);
+
+// Stops `timeout` without running its callback.
+void timeout_cancel(timeout_t *timeout);
+
+static inline bool timeout_pending(const timeout_t *timeout) {
+    return timeout->pending;
+}
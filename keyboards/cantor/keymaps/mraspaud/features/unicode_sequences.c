@@ -0,0 +1,52 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "unicode_sequences.h"
+#include "output_queue.h"
+#include "stack_watermark.h"
+
+// Converts the 5-bit modifiers of a modded keycode, where bit 4 selects the
+// right-hand side, to the 8-bit modifiers of a report.
+static uint8_t mod_bits(uint8_t mods) {
+    return (mods & 0x10) ? (mods & 0x0F) << 4 : mods;
+}
+
+void send_unicode_sequence(uint8_t index) {
+    if (index >= NUM_UNICODE_SEQUENCES) {
+        return;
+    }
+    stack_watermark_enter(STACK_WATERMARK_UNICODE);
+    unicode_sequence_t sequence;
+    memcpy_P(&sequence, &unicode_sequences[index], sizeof(sequence));
+
+    output_queue_begin();
+    output_queue_tap(QK_MODS_GET_BASIC_KEYCODE(UNICODE_KEY_LNX), mod_bits(QK_MODS_GET_MODS(UNICODE_KEY_LNX)));
+#if UNICODE_TYPE_DELAY > 0
+    output_queue_pause(UNICODE_TYPE_DELAY);
+#endif
+    for (uint8_t i = sequence.first; i < UNICODE_SEQUENCE_DIGITS; i++) {
+        output_queue_tap(sequence.digits[i], 0);
+    }
+    output_queue_tap(KC_SPC, 0);
+    output_queue_end();
+    stack_watermark_exit(STACK_WATERMARK_UNICODE);
+}
+
+bool process_unicode_sequences(const key_event_t *event, keyrecord_t *record) {
+    (void)record;
+    const uint16_t keycode = event->keycode;
+    uint16_t       index;
+    if (IS_QK_UNICODEMAP(keycode)) {
+        index = QK_UNICODEMAP_GET_INDEX(keycode);
+    } else if (IS_QK_UNICODEMAP_PAIR(keycode)) {
+        // Pick the shifted glyph with Shift xor Caps Lock, as QMK does.
+        const bool caps = host_keyboard_led_state().caps_lock;
+        index           = (event->shift ^ caps) ? QK_UNICODEMAP_PAIR_GET_SHIFTED_INDEX(keycode) : QK_UNICODEMAP_PAIR_GET_UNSHIFTED_INDEX(keycode);
+    } else {
+        return true;
+    }
+    if (event->pressed) {
+        send_unicode_sequence(index);
+    }
+    return false;
+}
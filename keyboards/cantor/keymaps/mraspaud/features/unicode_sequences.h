@@ -0,0 +1,75 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Unicode input from precomputed key sequences.
+//
+// QMK's Unicode support converts the code point to hex and taps every key of
+// the IBus Ctrl+Shift+U sequence one report at a time, with
+// UNICODE_TYPE_DELAY after the prologue. Here the hex digits of each glyph
+// are worked out by the compiler and stored in PROGMEM, and
+// send_unicode_sequence() queues them on output_queue.h, which packs them
+// as a hid_batch.h batch: the prologue in one report, then the digits and
+// Space pressed together in the next,
+//
+//     Ctrl+Shift+U, digit ... digit Space, release
+//
+// which is three reports for the whole glyph. Only a repeated digit needs a
+// report of its own to release the key in between. The first report is
+// sent right away and the others while the keyboard goes on scanning.
+//
+// The glyphs are listed once in the keymap, as an X-macro of names and code
+// points (comments inside the list must be block comments):
+//
+//     #define MY_UNICODE_GLYPHS(X) X(ACRC, 0x00E2) X(AACRC, 0x00C2)
+//     UNICODE_SEQUENCES(MY_UNICODE_GLYPHS);
+//
+// which declares `enum unicode_names` with one entry per glyph, for use in
+// UM() and UP() keycodes, and the sequence table. Register
+// process_unicode_sequences() in key_handlers[] (key_event.h) for
+// QK_UNICODEMAP to QK_UNICODEMAP_PAIR_MAX to handle those keycodes;
+// UNICODEMAP_ENABLE is then not needed.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "key_event.h"
+
+#ifndef UNICODE_KEY_LNX
+#    define UNICODE_KEY_LNX LCTL(LSFT(KC_U))
+#endif
+
+// Delay after the Ctrl+Shift+U prologue, for hosts that drop the first digit.
+#ifndef UNICODE_TYPE_DELAY
+#    define UNICODE_TYPE_DELAY 0
+#endif
+
+// Enough hex digits for any code point up to U+10FFFF.
+#define UNICODE_SEQUENCE_DIGITS 6
+
+typedef struct {
+    uint8_t first;  // Index of the first digit sent, skipping leading zeros.
+    uint8_t digits[UNICODE_SEQUENCE_DIGITS];
+} unicode_sequence_t;
+
+#define UNICODE_HEX_KEY_(d) ((d) == 0 ? KC_0 : (d) < 10 ? KC_1 + (d) - 1 : KC_A + (d) - 10)
+#define UNICODE_DIGIT_(cp, i) UNICODE_HEX_KEY_(((cp) >> (4 * (UNICODE_SEQUENCE_DIGITS - 1 - (i)))) & 0xF)
+#define UNICODE_LENGTH_(cp) ((cp) > 0xFFFFF ? 6 : (cp) > 0xFFFF ? 5 : (cp) > 0xFFF ? 4 : (cp) > 0xFF ? 3 : (cp) > 0xF ? 2 : 1)
+
+#define UNICODE_NAME_(name, cp) name,
+#define UNICODE_SEQUENCE_ENTRY_(name, cp)                                                                                                                           \
+    [name] = {.first  = UNICODE_SEQUENCE_DIGITS - UNICODE_LENGTH_(cp),                                                                                              \
+              .digits = {UNICODE_DIGIT_(cp, 0), UNICODE_DIGIT_(cp, 1), UNICODE_DIGIT_(cp, 2), UNICODE_DIGIT_(cp, 3), UNICODE_DIGIT_(cp, 4), UNICODE_DIGIT_(cp, 5)}},
+
+#define UNICODE_SEQUENCES(list)                                                         \
+    enum unicode_names { list(UNICODE_NAME_) };                                         \
+    const unicode_sequence_t unicode_sequences[] PROGMEM = {list(UNICODE_SEQUENCE_ENTRY_)}; \
+    uint8_t                  NUM_UNICODE_SEQUENCES       = ARRAY_SIZE(unicode_sequences)
+
+extern const unicode_sequence_t unicode_sequences[];
+extern uint8_t                  NUM_UNICODE_SEQUENCES;
+
+// Types glyph `index` of the table.
+void send_unicode_sequence(uint8_t index);
+
+// Handles UM() and UP() keycodes. Returns false when the keycode was handled.
+bool process_unicode_sequences(const key_event_t *event, keyrecord_t *record);
@@ -2,10 +2,32 @@
 // SPDX-License-Identifier: GPL-2.0
 #include QMK_KEYBOARD_H
 #include "keymap_extras/keymap_eurkey.h"
+#include "features/keymap_util.h"
+#include "features/key_event.h"
+#include "features/custom_shift_keys.h"
+#include "features/pos_combos.h"
+#include "features/unicode_sequences.h"
+#include "features/expansions.h"
+#include "features/timeouts.h"
+#include "features/latency.h"
+#include "features/profile.h"
+#include "features/stack_watermark.h"
+#include "features/scan_rate.h"
+#include "features/adaptive_term.h"
+#include "features/output_queue.h"
+#include "features/eager_dance.h"
+#include "features/key_history.h"
+#include "features/bigram.h"
+#include "features/speculative_tap.h"
+#include "features/finger_model.h"
+#include "chordal_hold.h"
+#ifdef RAW_ENABLE
+#    include "raw_hid.h"
+#endif
 #define QU_TIMEOUT 1000
-static uint16_t q_timer = 0;
-static uint16_t last_keycode = 0;
-static uint16_t sym_layer_timer = 0;
+// Open for QU_TIMEOUT after q: a vowel typed meanwhile gets a u first.
+static timeout_t qu_window = TIMEOUT_INIT(NULL);
+#define PROSE_INTERVAL 300  // ms between letters of prose, at most.
 
 // Layers declarations
 enum {
@@ -20,51 +42,31 @@ enum {
     L_FN,
 };
 
-enum unicode_names {
-    ACRC,
-    AACRC,
-    ECRC,
-    EECRC,
-    ICRC,
-    IICRC,
-    OCRC,
-    OOCRC,
-    UCRC,
-    UUCRC,
-    NDASH,
-    MDASH,
-    MINUS,
-    HYPHEN,
-    MIDPOINT,
-    LANGL,
-    RANGL,
-    SEQL,
-    GEQL,
-    ITBG,
-};
-
-const uint32_t PROGMEM unicode_map[] = {
-    [ACRC] = 0x00E2,  // â
-    [AACRC] = 0x00C2,  // Â
-    [ECRC] = 0x00EA,  // ê
-    [EECRC] = 0x00CA,  // Ê
-    [ICRC] = 0x00EE,  // î
-    [IICRC] = 0x00CE,  // Î
-    [OCRC] = 0x00F4,  // ô
-    [OOCRC] = 0x00D4,  // Ô
-    [UCRC] = 0x00FB,  // û
-    [UUCRC] = 0x00DB,  // Û
-    [NDASH] = 0x2013,  // –
-    [MDASH] = 0x2014,  // —
-    [MINUS] = 0x2212,  // −
-    [HYPHEN] = 0x002D,  // -
-    [LANGL] = 0x27E8, // ⟨
-    [RANGL] = 0x27E9, // ⟩
-    [SEQL] = 0x2264, // ≤
-    [GEQL] = 0x2265, // ≥
-    [ITBG] = 0x203D, // ‽
-    [MIDPOINT] = 0x00B7, // ·
-};
+#define MY_UNICODE_GLYPHS(X)        \
+    X(ACRC, 0x00E2)     /* â */     \
+    X(AACRC, 0x00C2)    /* Â */     \
+    X(ECRC, 0x00EA)     /* ê */     \
+    X(EECRC, 0x00CA)    /* Ê */     \
+    X(ICRC, 0x00EE)     /* î */     \
+    X(IICRC, 0x00CE)    /* Î */     \
+    X(OCRC, 0x00F4)     /* ô */     \
+    X(OOCRC, 0x00D4)    /* Ô */     \
+    X(UCRC, 0x00FB)     /* û */     \
+    X(UUCRC, 0x00DB)    /* Û */     \
+    X(NDASH, 0x2013)    /* – */     \
+    X(MDASH, 0x2014)    /* — */     \
+    X(MINUS, 0x2212)    /* − */     \
+    X(HYPHEN, 0x002D)   /* - */     \
+    X(MIDPOINT, 0x00B7) /* · */     \
+    X(LANGL, 0x27E8)    /* ⟨ */     \
+    X(RANGL, 0x27E9)    /* ⟩ */     \
+    X(SEQL, 0x2264)     /* ≤ */     \
+    X(GEQL, 0x2265)     /* ≥ */     \
+    X(ITBG, 0x203D)     /* ‽ */     \
+    X(UGRV, 0x00F9)     /* ù */     \
+    X(UUGRV, 0x00D9)    /* Ù */
+
+UNICODE_SEQUENCES(MY_UNICODE_GLYPHS);
 
 #define U_ACRC UP(ACRC, AACRC)
 #define U_ECRC UP(ECRC, EECRC)
@@ -81,10 +83,31 @@ const uint32_t PROGMEM unicode_map[] = {
 #define MAGICFR OSL(L_FRSYM)
 
 enum custom_keycodes {
-    CKC_OU = SAFE_RANGE,
+    CKC_TLD = SAFE_RANGE,
+    // Expansions, in the order of expansions[].
     DI_TH,
-    CKC_TLD,
+    DI_CH,
+    DI_SH,
+    DI_QU,
+    CKC_OU,
+    QU_U,  // The u added after q.
+};
+
+const expansion_t expansions[] PROGMEM = {
+    [DI_TH - DI_TH] = {{"th", "Th", "TH"}},
+    [DI_CH - DI_TH] = {{"ch", "Ch", "CH"}},
+    [DI_SH - DI_TH] = {{"sh", "Sh", "SH"}},
+    [DI_QU - DI_TH] = {{"qu", "Qu", "QU"}},
+    [CKC_OU - DI_TH] = {{{'o', EXPANSION_GLYPH(UGRV)}, {'O', EXPANSION_GLYPH(UGRV)}, {'O', EXPANSION_GLYPH(UUGRV)}}},
+    [QU_U - DI_TH] = {{"u", "U", "U"}},
 };
+uint8_t NUM_EXPANSIONS = ARRAY_SIZE(expansions);
+_Static_assert(ARRAY_SIZE(expansions) == QU_U - DI_TH + 1, "expansions[] must cover DI_TH to QU_U");
+
+// Digraph keys type letters too.
+bool key_history_in_word(uint16_t keycode) {
+    return keycode >= DI_TH && keycode <= QU_U;
+}
 
 // Tap Dance declarations
 enum {
@@ -96,10 +119,10 @@ enum {
 
 // Tap Dance definitions
 tap_dance_action_t tap_dance_actions[] = {
-    // Tap once for Escape, twice for Caps Lock
-    [TD_ADIA] = ACTION_TAP_DANCE_DOUBLE(EU_ADIA, EU_AE),
-    [TD_ODIA] = ACTION_TAP_DANCE_DOUBLE(EU_ODIA, EU_OSTR),
-    [TD_CURR] = ACTION_TAP_DANCE_DOUBLE(EU_EURO, EU_PND),
+    // ä, ö and € go out on the press; a second tap changes them to æ, ø, £.
+    [TD_ADIA] = ACTION_TAP_DANCE_EAGER(EU_ADIA, EU_AE),
+    [TD_ODIA] = ACTION_TAP_DANCE_EAGER(EU_ODIA, EU_OSTR),
+    [TD_CURR] = ACTION_TAP_DANCE_EAGER(EU_EURO, EU_PND),
     // [TD_THRN] = ACTION_TAP_DANCE_DOUBLE(DI_TH, EU_THRN),
 };
 
@@ -124,59 +147,12 @@ tap_dance_action_t tap_dance_actions[] = {
 #define MT_DGRV LSFT_T(EU_DGRV)
 
 
-bool is_shift_pressed(keyrecord_t *record) {
-    const uint8_t saved_mods = get_mods();
-#ifndef NO_ACTION_ONESHOT
-    const uint8_t mods = saved_mods | get_oneshot_mods();
-#else
-    const uint8_t mods = saved_mods;
-#endif  // NO_ACTION_ONESHOT
-#if CUSTOM_SHIFT_KEYS_LAYER_MASK != 0
-    const uint8_t layer = read_source_layers_cache(record->event.key);
-#endif  // CUSTOM_SHIFT_KEYS_LAYER_MASK
-    if ((mods & MOD_MASK_SHIFT) != 0  // Shift is held.
-#if CUSTOM_SHIFT_KEYS_NEGMODS != 0
-        // Nothing in CUSTOM_SHIFT_KEYS_NEGMODS is held.
-        && (mods & (CUSTOM_SHIFT_KEYS_NEGMODS)) == 0
-#endif  // CUSTOM_SHIFT_KEYS_NEGMODS != 0
-#if CUSTOM_SHIFT_KEYS_LAYER_MASK != 0
-        // Pressed key is on a layer appearing in the layer mask.
-        && ((1 << layer) & (CUSTOM_SHIFT_KEYS_LAYER_MASK)) != 0
-#endif  // CUSTOM_SHIFT_KEYS_LAYER_MASK
-    ) {
-        return true;
-    } else {
-        return false;
-    }
-}
-
-void send_unshifted_string(const char *string) {
-    // Send a string without changing capitalisation.
-    const uint8_t saved_mods = get_mods();
-#ifndef NO_ACTION_ONESHOT
-    const uint8_t mods = saved_mods | get_weak_mods() | get_oneshot_mods();
-#else
-    const uint8_t mods = saved_mods | get_weak_mods();
-#endif  // NO_ACTION_ONESHOT
-
-    // cancel shift mods, press the key, and restore mods.
-    del_weak_mods(MOD_MASK_SHIFT);
-#ifndef NO_ACTION_ONESHOT
-    del_oneshot_mods(MOD_MASK_SHIFT);
-#endif  // NO_ACTION_ONESHOT
-    unregister_mods(MOD_MASK_SHIFT);
-    set_oneshot_mods(MOD_BIT(KC_LSFT));
-    SEND_STRING(string);
-    set_mods(mods);
-}
-
-
-bool caps_word_press_user(uint16_t keycode) {
+static bool caps_word_press_keymap(uint16_t keycode) {
     switch (keycode) {
         // Keycodes that continue Caps Word, with shift applied.
         case KC_A ... KC_Z:
         case KC_MINS:
-        case DI_TH:
+        case DI_TH ... QU_U:
             add_weak_mods(MOD_BIT(KC_LSFT));  // Apply shift to next key.
             return true;
 
@@ -192,94 +168,139 @@ bool caps_word_press_user(uint16_t keycode) {
     }
 }
 
-bool process_record_user(uint16_t keycode, keyrecord_t *record) {
-    // Check if the 'qu' timer is currently active
-    if (q_timer != 0) {
-        // If more time has passed than our timeout, cancel the 'qu' action
-        if (timer_elapsed(q_timer) > QU_TIMEOUT) {
-            q_timer = 0;
+bool caps_word_press_user(uint16_t keycode) {
+    profile_enter(PROFILE_CAPS_WORD);
+    const bool result = caps_word_press_keymap(keycode);
+    profile_exit(PROFILE_CAPS_WORD);
+    return result;
+}
+
+static bool process_tilde(const key_event_t *event, keyrecord_t *record) {
+    (void)record;
+    // Send tilde directly. This is to avoid having ~/ become ~* (the shift in tilde bleeds into / otherwise).
+    if (event->pressed) {
+        tap_code16(EU_TILD);
+    }
+    return false;
+}
+
+static bool process_expansion_keys(const key_event_t *event, keyrecord_t *record) {
+    (void)record;
+    send_expansion(event, event->keycode - DI_TH);
+    return true;
+}
+
+// q opens the Qu window (but not vim's :q), and a vowel typed while it is
+// open gets a u first. Any other key closes it, in process_record_user().
+static bool process_qu(const key_event_t *event, keyrecord_t *record) {
+    (void)record;
+    if (!event->pressed) {
+        return true;
+    }
+    if (event->keycode == KC_Q) {
+        if (key_history_keycode(0) != EU_COLN) {
+            timeout_start(&qu_window, QU_TIMEOUT);
         }
+    } else if (timeout_pending(&qu_window)) {
+        timeout_cancel(&qu_window);
+        send_expansion(event, QU_U - DI_TH);
+    }
+    return true;
+}
+
+// Run in this order, each only for the keycodes in its range.
+const key_handler_t key_handlers[] = {
+    // Every key: taps are timed against the keys pressed in between, a
+    // speculative tap can be taken by any combo, and a custom shift key is
+    // released by the next event.
+    KEY_HANDLER(0, UINT16_MAX, process_adaptive_term),
+    KEY_HANDLER(0, UINT16_MAX, process_speculative_tap),
+    KEY_HANDLER(0, UINT16_MAX, process_custom_shift_keys),
+    KEY_HANDLER(CKC_TLD, CKC_TLD, process_tilde),
+    KEY_HANDLER(DI_TH, CKC_OU, process_expansion_keys),
+    // q and the vowels that follow it, from wherever they come: basic
+    // keycodes, the mod-tap MT_E, AltGr keycodes and UP() glyphs.
+    KEY_HANDLER(KC_Q, KC_Q, process_qu),
+    KEY_HANDLER(KC_A, KC_A, process_qu),
+    KEY_HANDLER(MT_E, MT_E, process_qu),
+    KEY_HANDLER(KC_I, KC_I, process_qu),
+    KEY_HANDLER(KC_O, KC_O, process_qu),
+    KEY_HANDLER(KC_Y, KC_Y, process_qu),
+    KEY_HANDLER(EU_QUOT, EU_QUOT, process_qu),
+    KEY_HANDLER(EU_RSQU, EU_RSQU, process_qu),
+    KEY_HANDLER(EU_EACU, EU_EACU, process_qu),
+    KEY_HANDLER(EU_EGRV, EU_EGRV, process_qu),
+    KEY_HANDLER(U_ACRC, U_ACRC, process_qu),
+    KEY_HANDLER(U_ECRC, U_ECRC, process_qu),
+    KEY_HANDLER(U_ICRC, U_ICRC, process_qu),
+    KEY_HANDLER(QK_UNICODEMAP, QK_UNICODEMAP_PAIR_MAX, process_unicode_sequences),
+};
+uint8_t NUM_KEY_HANDLERS = ARRAY_SIZE(key_handlers);
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    profile_enter(PROFILE_PROCESS);
+    stack_watermark_enter(STACK_WATERMARK_PROCESS);
+    // A key that waited behind a tap-hold key goes out after the macros
+    // typed before it.
+    output_queue_flush();
+    latency_user_enter(keycode, record);
+    const key_event_t event  = key_event_snapshot(keycode, record);
+    const bool        result = process_key_handlers(&event, record);
+    if (result) {
+        // The key goes on to send its own report (the vowel after a "u").
+        output_queue_flush();
+    }
+    // Holds and modifiers close the Qu window as well: "q", Shift held, "a"
+    // is "qA". The one-shot French symbol layer leaves it open for its vowels.
+    if (event.pressed && event.keycode != KC_Q && event.keycode != MAGICFR) {
+        timeout_cancel(&qu_window);
     }
+    key_history_record(&event, record);
+    bigram_record(record);
+    latency_user_exit(record);
+    stack_watermark_exit(STACK_WATERMARK_PROCESS);
+    profile_exit(PROFILE_PROCESS);
+    return result;
+}
+
+const uint16_t adaptive_term_keys[] PROGMEM = {MT_S, MT_N, MT_E, MT_M, LT_R, LT_SPC};
+uint8_t        NUM_ADAPTIVE_TERM_KEYS = ARRAY_SIZE(adaptive_term_keys);
 
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    (void)record;
+    return adaptive_term_get(keycode);
+}
+
+// Speculative mods only on the typing layers. On a momentary layer, the
+// layer key can come up before the mod-tap settles, which then resolves on
+// the layer below: MT_1 held as RSFT_T(KC_E) would leave its Shift on.
+bool get_speculative_hold(uint16_t keycode, keyrecord_t *record) {
+    (void)record;
     switch (keycode) {
-        case CKC_TLD:
-            // Send tilde directly. This is to avoid having ~/ become ~* (the shift in tilde bleeds into / otherwise).
-            if (record->event.pressed) {
-                tap_code16(EU_TILD);
-            }
-            return false;
-        case CKC_OU:
-            if (record->event.pressed) {
-                if (is_shift_pressed(record)) {
-                    SEND_STRING("O");
-                } else {
-                    SEND_STRING("o");
-                }
-                send_unicode_string("ù");
-            } else {
-                // when keycode QMKBEST is released
-            }
-            break;
-        case DI_TH:
-            if (record->event.pressed) {
-                if (is_caps_word_on()) {
-                    SEND_STRING("TH");
-                } else if (is_shift_pressed(record)) {
-                    send_unshifted_string("Th");
-                } else {
-                    SEND_STRING("th");
-                }
-            } else {
-                // key release
-            }
-            break;
-        case KC_Q:
-            if (record->event.pressed) {
-                if (last_keycode != EU_COLN) {
-                    q_timer = timer_read();
-                }
-            }
-            break;
-        case KC_A:
+        case MT_S:
+        case MT_N:
         case MT_E:
-        case KC_I:
-        case KC_O:
-        case KC_Y:
-        case EU_EACU:
-        case U_ACRC:
-        case U_ECRC:
-        case EU_EGRV:
-        case U_ICRC:
-        case EU_QUOT:
-        case EU_RSQU:
-            if (record->event.pressed) {
-                if (q_timer != 0) {
-                    q_timer = 0;
-                    if (is_caps_word_on()) {
-                        SEND_STRING("U");
-                    } else {
-                        tap_code(KC_U);
-                    }
-                }
-            }
-            break;
-        case MAGICFR:
-            break;
+        case MT_M:
+            return true;
         default:
-            if (record->event.pressed) {
-                q_timer = 0;
-            }
-            break;
+            return false;
     }
-    if (record->event.pressed) {
-        last_keycode = keycode;
+}
+
+// R and Space type on the press while typing prose: right after a letter,
+// when holding them for numbers or navigation is unlikely.
+bool get_speculative_tap(uint16_t keycode, keyrecord_t *record) {
+    (void)record;
+    switch (keycode) {
+        case LT_R:
+        case LT_SPC:
+            return key_history_word_length() > 0 && key_history_age(0) < PROSE_INTERVAL;
+        default:
+            return false;
     }
-    // your code here
-    return true;
 }
 
-uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t* record,
-                           uint16_t prev_keycode) {
+static uint16_t flow_tap_term_keymap(uint16_t keycode, uint16_t prev_keycode) {
     if (is_flow_tap_key(keycode) && is_flow_tap_key(prev_keycode)) {
         switch (keycode) {
             case MT_E:
@@ -295,40 +316,71 @@ uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t* record,
     return 0;  // Disable Flow Tap.
 }
 
+uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t *record, uint16_t prev_keycode) {
+    (void)record;
+    profile_enter(PROFILE_FLOW_TAP);
+    const uint16_t term = flow_tap_term_keymap(keycode, prev_keycode);
+    profile_exit(PROFILE_FLOW_TAP);
+    return term;
+}
 
- const custom_shift_key_t custom_shift_keys[] = {
-  {KC_DOT , KC_EXLM}, // Shift . is !
-  {KC_COMM, KC_QUES}, // Shift , is :
-  {KC_COLN, KC_SCLN}, // Shift : is ;
-  {EU_DQUO, EU_GRV }, // Shift " is `
-  {KC_UNDS, KC_MINS }, // Shift _ is -
-  {KC_LBRC, KC_LCBR }, // Shift [ is {
-  {KC_RBRC, KC_RCBR }, // Shift ] is }
-  {KC_LPRN, KC_LABK }, // Shift ( is <
-  {KC_RPRN, KC_RABK }, // Shift } is >
-  {KC_SLSH, EU_ASTR }, // Shift / is *
-  {EU_QUOT, EU_RSQU }, // Shift ' is ’
-  {KC_EQL, KC_PLUS}, // Shift = is +
-  {EU_AT, EU_HASH}, // Shift @ is #
-  {EU_RSQU, EU_RDQU}, // Shift ‘ is “
-  {EU_LSQU, EU_LDQU}, // Shift ’ is ”
-  {EU_RDAQ, EU_RDQU}, // Shift « is “
-  {EU_LDAQ, EU_LDQU}, // Shift » is ”
-  {EU_DEG, EU_IQUE}, // Shift ° is ¿
-  {CK_NNBS, CK_NBSP},
-  {KC_BSPC, KC_DELETE},
-  {EU_ELLP, EU_MDDT}, // Shift … is ·
 
+// Each key may appear only once: a duplicate is a compile error.
+#define MY_CUSTOM_SHIFT_KEYS(X)             \
+    X(KC_DOT, KC_EXLM)   /* Shift . is ! */ \
+    X(KC_COMM, KC_QUES)  /* Shift , is : */ \
+    X(KC_COLN, KC_SCLN)  /* Shift : is ; */ \
+    X(EU_DQUO, EU_GRV)   /* Shift " is ` */ \
+    X(KC_UNDS, KC_MINS)  /* Shift _ is - */ \
+    X(KC_LBRC, KC_LCBR)  /* Shift [ is { */ \
+    X(KC_RBRC, KC_RCBR)  /* Shift ] is } */ \
+    X(KC_LPRN, KC_LABK)  /* Shift ( is < */ \
+    X(KC_RPRN, KC_RABK)  /* Shift } is > */ \
+    X(KC_SLSH, EU_ASTR)  /* Shift / is * */ \
+    X(EU_QUOT, EU_RSQU)  /* Shift ' is ’ */ \
+    X(KC_EQL, KC_PLUS)   /* Shift = is + */ \
+    X(EU_AT, EU_HASH)    /* Shift @ is # */ \
+    X(EU_RSQU, EU_RDQU)  /* Shift ‘ is “ */ \
+    X(EU_LSQU, EU_LDQU)  /* Shift ’ is ” */ \
+    X(EU_RDAQ, EU_RDQU)  /* Shift « is “ */ \
+    X(EU_LDAQ, EU_LDQU)  /* Shift » is ” */ \
+    X(EU_DEG, EU_IQUE)   /* Shift ° is ¿ */ \
+    X(CK_NNBS, CK_NBSP)                     \
+    X(KC_BSPC, KC_DELETE)                   \
+    X(EU_ELLP, EU_MDDT)  /* Shift … is · */
+
+CUSTOM_SHIFT_KEYS(MY_CUSTOM_SHIFT_KEYS);
+
+
+// How each key is reached, in LAYOUT_split_3x6_3 order: the index fingers
+// take the two inner columns, the pinkies the two outer ones. sim/chordal.c
+// compiles it into chordal_hold.h.
+#define LPNK FINGER_LEFT_PINKY
+#define LRNG FINGER_LEFT_RING
+#define LMID FINGER_LEFT_MIDDLE
+#define LIDX FINGER_LEFT_INDEX
+#define LTHB FINGER_LEFT_THUMB
+#define RTHB FINGER_RIGHT_THUMB
+#define RIDX FINGER_RIGHT_INDEX
+#define RMID FINGER_RIGHT_MIDDLE
+#define RRNG FINGER_RIGHT_RING
+#define RPNK FINGER_RIGHT_PINKY
+const finger_key_t finger_model[FINGER_MODEL_KEYS] = {
+    {LPNK, 0,  0}, {LPNK, 0,  1}, {LRNG, 0,  2}, {LMID, 0,  3}, {LIDX, 0,  4}, {LIDX, 0,  5},  {RIDX, 0,  6}, {RIDX, 0,  7}, {RMID, 0,  8}, {RRNG, 0,  9}, {RPNK, 0, 10}, {RPNK, 0, 11},
+    {LPNK, 1,  0}, {LPNK, 1,  1}, {LRNG, 1,  2}, {LMID, 1,  3}, {LIDX, 1,  4}, {LIDX, 1,  5},  {RIDX, 1,  6}, {RIDX, 1,  7}, {RMID, 1,  8}, {RRNG, 1,  9}, {RPNK, 1, 10}, {RPNK, 1, 11},
+    {LPNK, 2,  0}, {LPNK, 2,  1}, {LRNG, 2,  2}, {LMID, 2,  3}, {LIDX, 2,  4}, {LIDX, 2,  5},  {RIDX, 2,  6}, {RIDX, 2,  7}, {RMID, 2,  8}, {RRNG, 2,  9}, {RPNK, 2, 10}, {RPNK, 2, 11},
+                                                 {LTHB, 3,  3}, {LTHB, 3,  4}, {LTHB, 3,  5},  {RTHB, 3,  6}, {RTHB, 3,  7}, {RTHB, 3,  8},
 };
-
-
-const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS] PROGMEM =
-    LAYOUT_split_3x6_3(
-        'L', 'L', 'L', 'L', 'L', 'L',  'R', 'R', 'R', 'R', 'R', 'R',
-        'L', 'L', 'L', 'L', 'L', 'L',  'R', 'R', 'R', 'R', 'R', 'R',
-        'L', 'L', 'L', 'L', 'L', 'L',  'R', 'R', 'R', 'R', 'R', 'R',
-                       '*', '*', '*',  '*', '*', '*'
-    );
+#undef LPNK
+#undef LRNG
+#undef LMID
+#undef LIDX
+#undef LTHB
+#undef RTHB
+#undef RIDX
+#undef RMID
+#undef RRNG
+#undef RPNK
 
 
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
@@ -475,65 +527,143 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
 };
 
 
-const uint16_t PROGMEM combo_tab[] = {KC_C, KC_T, COMBO_END};
-const uint16_t PROGMEM combo_backspace[] = {KC_SLASH, KC_J, COMBO_END};
-const uint16_t PROGMEM combo_delete[] = {KC_X, KC_J, COMBO_END};
-const uint16_t PROGMEM combo_backspace_se[] = {SE_ADIA, KC_J, COMBO_END};
-const uint16_t PROGMEM combo_backspace_fr[] = {EU_EACU, KC_J, COMBO_END};
-const uint16_t PROGMEM combo_backspace_sym[] = {KC_SLSH, CKC_TLD, COMBO_END};
-const uint16_t PROGMEM combo_prtscr[] = {EU_COLN, KC_DOT, COMBO_END};
-const uint16_t PROGMEM combo_capsword[] = {KC_LPRN, KC_RPRN, COMBO_END};
-const uint16_t PROGMEM combo_bootloader[] = {EU_DQUO, EU_COLN, COMBO_END};
-const uint16_t PROGMEM combo_kb_reboot[] = {EU_AT, KC_Z, COMBO_END};
-const uint16_t PROGMEM combo_sleep[] = {KC_COMM, KC_EQL, COMBO_END};
-const uint16_t PROGMEM combo_enter[] = {KC_A, KC_I, COMBO_END};
-const uint16_t PROGMEM combo_en[] = {MT_N, MT_E, COMBO_END};
-const uint16_t PROGMEM combo_se[] = {MT_S, MT_E, COMBO_END};
-const uint16_t PROGMEM combo_fr[] = {KC_F, LT_R, COMBO_END};
-const uint16_t PROGMEM combo_base[] = {KC_P, KC_L, KC_D, COMBO_END};
-combo_t key_combos[] = {
-    COMBO(combo_tab, KC_TAB),
-    COMBO(combo_backspace, KC_BSPC),
-    COMBO(combo_delete, KC_DEL),
-    COMBO(combo_backspace_se, KC_BSPC),
-    COMBO(combo_backspace_fr, KC_BSPC),
-    COMBO(combo_backspace_sym, KC_BSPC),
-    COMBO(combo_prtscr, KC_PRINT_SCREEN),
-    COMBO(combo_capsword, CW_TOGG),
-    COMBO(combo_bootloader, QK_BOOT),
-    COMBO(combo_kb_reboot, QK_RBT),
-    COMBO(combo_sleep, KC_SYSTEM_SLEEP),
-    COMBO(combo_enter, KC_ENT),
-    COMBO(combo_fr, TO(L_FR)),
-    COMBO(combo_se, TO(L_SE)),
-    COMBO(combo_en, TO(L_EN)),
-    COMBO(combo_base, TO(L_BASE)),
+// Key positions for combos, named after the base layer.
+enum combo_positions {
+    P_NONE = 0,
+    P_Z, P_B, P_W, P_H, P_G, P_DQUO,        P_COLN, P_DOT, P_SLSH, P_J, P_X, P_AT,
+    P_LPRN, P_S, P_C, P_N, P_T, P_K,        P_COMM, P_A, P_E, P_I, P_M, P_RPRN,
+    P_LBRC, P_F, P_P, P_L, P_D, P_V,        P_EQL, P_U, P_O, P_Y, P_TH, P_RBRC,
+                      P_Q, P_R, P_ESC,      P_UNDS, P_SPC, P_QUOT,
 };
 
-// The backspace combo lands on the ~/ keys that I often type in rapid succession, leading to strange behaviour if the
-// combo is active. Since I usually type ~/ just after switching to the sym layer, we are here delaying the activation
-// of the combo by a half second.
-
-layer_state_t layer_state_set_user(layer_state_t state) {
-    // If the symbol layer is turned on, record the current time
-    if (get_highest_layer(state) == L_NUMSYM) {
-        sym_layer_timer = timer_read();
-    } else {
-        // Reset the timer when leaving the layer
-        sym_layer_timer = 0;
-    }
-    return state;
+const uint8_t pos_combo_positions[MATRIX_ROWS][MATRIX_COLS] PROGMEM =
+    LAYOUT_split_3x6_3(
+        P_Z,    P_B, P_W, P_H, P_G, P_DQUO,  P_COLN, P_DOT, P_SLSH, P_J, P_X,  P_AT,
+        P_LPRN, P_S, P_C, P_N, P_T, P_K,     P_COMM, P_A,   P_E,    P_I, P_M,  P_RPRN,
+        P_LBRC, P_F, P_P, P_L, P_D, P_V,     P_EQL,  P_U,   P_O,    P_Y, P_TH, P_RBRC,
+                          P_Q, P_R, P_ESC,   P_UNDS, P_SPC, P_QUOT
+    );
+
+#define TYPING_LAYERS (LAYER_BIT(L_BASE) | LAYER_BIT(L_EN) | LAYER_BIT(L_SE) | LAYER_BIT(L_FR))
+
+enum combo_names {
+    C_TAB,
+    C_BSPC,
+    C_BSPC_SYM,
+    C_DEL,
+    C_PSCR,
+    C_CAPS,
+    C_BOOT,
+    C_REBOOT,
+    C_SLEEP,
+    C_ENTER,
+    C_FR,
+    C_SE,
+    C_EN,
+    C_BASE,
+};
+
+// Each combo is listed once, with the layers where its keys are in place.
+// Those on keys that are also rolled when typing (ct, ai) want a pause before
+// them, shorter in fast typing; ~/ typed right after switching to the symbol
+// layer wants half a second at any speed. Backspace is
+// there on the typing layers straight away, to correct a typo mid-word. On
+// the Swedish one, ä on the / key still goes out on the press: the combo
+// takes it back when J follows.
+const pos_combo_t pos_combos[] PROGMEM = {
+    [C_TAB] = POS_COMBO_ROLLED(KC_TAB, TYPING_LAYERS, 150, P_C, P_T),
+    [C_BSPC] = POS_COMBO(KC_BSPC, TYPING_LAYERS, P_SLSH, P_J),
+    [C_BSPC_SYM] = POS_COMBO_PAUSED(KC_BSPC, LAYER_BIT(L_NUMSYM), 500, P_SLSH, P_J),
+    [C_DEL] = POS_COMBO(KC_DEL, TYPING_LAYERS | LAYER_BIT(L_FRSYM), P_X, P_J),
+    [C_PSCR] = POS_COMBO(KC_PRINT_SCREEN, TYPING_LAYERS | LAYER_BIT(L_NUMSYM), P_COLN, P_DOT),
+    [C_CAPS] = POS_COMBO(CW_TOGG, TYPING_LAYERS | LAYER_BIT(L_NUMSYM) | LAYER_BIT(L_FRSYM), P_LPRN, P_RPRN),
+    [C_BOOT] = POS_COMBO(QK_BOOT, TYPING_LAYERS | LAYER_BIT(L_NUMSYM), P_DQUO, P_COLN),
+    [C_REBOOT] = POS_COMBO(QK_RBT, TYPING_LAYERS | LAYER_BIT(L_FRSYM), P_AT, P_Z),
+    [C_SLEEP] = POS_COMBO(KC_SYSTEM_SLEEP, LAYER_BIT(L_BASE) | LAYER_BIT(L_EN) | LAYER_BIT(L_NUMSYM), P_COMM, P_EQL),
+    [C_ENTER] = POS_COMBO_ROLLED(KC_ENT, TYPING_LAYERS, 150, P_A, P_I),
+    [C_FR] = POS_COMBO(TO(L_FR), TYPING_LAYERS | LAYER_BIT(L_FRSYM), P_F, P_R),
+    [C_SE] = POS_COMBO(TO(L_SE), TYPING_LAYERS, P_S, P_E),
+    [C_EN] = POS_COMBO(TO(L_EN), TYPING_LAYERS, P_N, P_E),
+    [C_BASE] = POS_COMBO(TO(L_BASE), TYPING_LAYERS | LAYER_BIT(L_FRSYM), P_P, P_L, P_D),
+};
+uint8_t NUM_POS_COMBOS = ARRAY_SIZE(pos_combos);
+
+bool pos_combo_eager(uint16_t keycode) {
+    return is_eager_dance(keycode);
 }
 
-bool combo_should_trigger(uint16_t combo_index, combo_t *combo, uint16_t keycode, keyrecord_t *record) {
-    if (combo->keys == combo_backspace_sym) {
-        if (IS_LAYER_ON(L_NUMSYM)) {
-            // If the timer is active AND less than 500ms has passed, disable the combo
-            if (sym_layer_timer != 0 && timer_elapsed(sym_layer_timer) < 500) {
-                return false;
-            }
-        }
+void pos_combo_take_back(uint16_t keycode) {
+    eager_dance_take_back(keycode);
+}
+
+// Bit MATRIX_INDEX(other) of the entry at the tap-hold key's row and column
+// tells whether it may settle as a hold when the key `other` is pressed.
+static const uint32_t chordal_hold_matrix[MATRIX_ROWS][MATRIX_COLS][2] PROGMEM = CHORDAL_HOLD_MATRIX;
+
+bool get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record, uint16_t other_keycode, keyrecord_t *other_record) {
+    (void)tap_hold_keycode;
+    (void)other_keycode;
+    if (tap_hold_record->event.type != KEY_EVENT || other_record->event.type != KEY_EVENT) {
+        return true;  // Combos.
     }
-    return true;
+    const keypos_t tap_hold = tap_hold_record->event.key;
+    const uint8_t  other    = MATRIX_INDEX(other_record->event.key);
+    return (pgm_read_dword(&chordal_hold_matrix[tap_hold.row][tap_hold.col][other >> 5]) >> (other & 31)) & 1;
+}
+
+#ifdef BIGRAM_ENABLE
+const layer_state_t bigram_layers = LAYER_BIT(L_EN) | LAYER_BIT(L_SE) | LAYER_BIT(L_FR) | LAYER_BIT(L_NUMSYM);
+
+// The index of `key` in LAYOUT_split_3x6_3, as thornium.yaml lists them.
+uint8_t bigram_position(keypos_t key) {
+    return pgm_read_byte(&pos_combo_positions[key.row][key.col]) - 1;
+}
+#endif
+
+void keyboard_post_init_user(void) {
+    stack_watermark_init();
+    timeouts_init();
+    latency_init();
+    key_history_init();
+    profile_init();
+    adaptive_term_init();
+    bigram_init();
+    pos_combos_init();
+    scan_rate_init();
 }
 
+void eeconfig_init_user(void) {
+    adaptive_term_reset();
+    bigram_reset();
+}
+
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    latency_event_seen(record);
+    output_queue_flush();
+    scan_rate_record(record);
+    profile_enter(PROFILE_PRE_PROCESS);
+    pre_process_speculative_tap(keycode, record);
+    stack_watermark_enter(STACK_WATERMARK_COMBOS);
+    const bool result = process_pos_combos(keycode, record);
+    stack_watermark_exit(STACK_WATERMARK_COMBOS);
+    profile_exit(PROFILE_PRE_PROCESS);
+    return result;
+}
+
+void matrix_scan_user(void) {
+    profile_scan();
+    stack_watermark_scan();
+}
+
+void housekeeping_task_user(void) {
+    scan_rate_task();
+}
+
+#ifdef RAW_ENABLE
+// Each instrumented feature answers the requests tagged with its own ID.
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (!latency_raw_hid_receive(data, length)) {
+        bigram_raw_hid_receive(data, length);
+    }
+}
+#endif
@@ -1,7 +1,6 @@
-COMBO_ENABLE = yes
+COMBO_ENABLE = no
 TAP_DANCE_ENABLE = yes
-UNICODE_COMMON = yes
-UNICODEMAP_ENABLE = yes
+UNICODEMAP_ENABLE = no
 BOOTMAGIC_ENABLE = yes
 LTO_ENABLE = yes
 DEFERRED_EXEC_ENABLE = yes
@@ -10,3 +9,57 @@ LAYER_LOCK_ENABLE = yes
 REPEAT_KEY_ENABLE = yes
 OPT_DEFS += -DOTG_NO_VBUS_SENSE
 USB_SUSPEND_ENABLE = no
+SRC += features/key_event.c
+SRC += features/custom_shift_keys.c
+SRC += features/pos_combos.c
+SRC += features/unicode_sequences.c
+SRC += features/expansions.c
+SRC += features/timeouts.c
+SRC += features/adaptive_term.c
+SRC += features/hid_batch.c
+SRC += features/output_queue.c
+SRC += features/eager_dance.c
+SRC += features/key_history.c
+SRC += features/speculative_tap.c
+SRC += features/scan_rate.c
+
+# Latency histograms for instrumented builds: qmk compile -e LATENCY_ENABLE=yes
+LATENCY_ENABLE ?= no
+ifeq ($(strip $(LATENCY_ENABLE)), yes)
+    SRC += features/latency.c
+    OPT_DEFS += -DLATENCY_ENABLE
+    RAW_ENABLE = yes
+endif
+
+# Scan rate and hook cost on the console: qmk compile -e PROFILE_ENABLE=yes
+PROFILE_ENABLE ?= no
+ifeq ($(strip $(PROFILE_ENABLE)), yes)
+    SRC += features/profile.c
+    OPT_DEFS += -DPROFILE_ENABLE
+    CONSOLE_ENABLE = yes
+endif
+
+# Stack high-water marks on the console: qmk compile -e STACK_WATERMARK_ENABLE=yes
+STACK_WATERMARK_ENABLE ?= no
+ifeq ($(strip $(STACK_WATERMARK_ENABLE)), yes)
+    SRC += features/stack_watermark.c
+    OPT_DEFS += -DSTACK_WATERMARK_ENABLE
+    CONSOLE_ENABLE = yes
+endif
+
+# Bigram counts in EEPROM, read with tools/bigram.py: qmk compile -e BIGRAM_ENABLE=yes
+BIGRAM_ENABLE ?= no
+ifeq ($(strip $(BIGRAM_ENABLE)), yes)
+    SRC += features/bigram.c
+    OPT_DEFS += -DBIGRAM_ENABLE
+    RAW_ENABLE = yes
+endif
+
+# `make cantor:mraspaud:size-report` builds the firmware, then charges its
+# flash and RAM to the keymap's tables and to each enabled feature, writes
+# the report next to the ELF and fails if size_budget.json is exceeded.
+ifneq ($(filter size-report,$(MAKECMDGOALS)),)
+size-report: $(BUILD_DIR)/$(TARGET).elf
+	python3 $(KEYMAP_PATH)/tools/size_report.py --nm $(NM) --budget $(KEYMAP_PATH)/size_budget.json $<
+.PHONY: size-report
+endif
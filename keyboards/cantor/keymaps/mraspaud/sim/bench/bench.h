@@ -0,0 +1,37 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Helpers shared by the host benchmarks.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "sim.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#    define BENCH_UNIT "cycles"
+static inline uint64_t bench_now(void) {
+    return __rdtsc();
+}
+#else
+#    define BENCH_UNIT "ns"
+static inline uint64_t bench_now(void) {
+    return sim_wall_ns();
+}
+#endif
+
+// Keeps the compiler from optimising away a benchmarked result.
+static inline void bench_consume(uint64_t value) {
+    __asm__ volatile("" : : "r"(value) : "memory");
+}
+
+// Small deterministic PRNG (xorshift32), so runs are comparable.
+static inline uint32_t bench_random(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
@@ -0,0 +1,126 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Bigram sketch: cost of counting a key press, and how far the counts read
+// back are from the true ones, with keys drawn from a skewed distribution as
+// letters are. No count may be below the true one, and the sketch must read
+// back the same once saved to EEPROM and loaded again.
+//
+// Needs BIGRAM_ENABLE=yes (make clean bench BIGRAM_ENABLE=yes).
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "features/bigram.h"
+
+#ifdef BIGRAM_ENABLE
+
+#    define PRESSES 200000
+#    define KEYS 42
+
+static uint32_t truth[KEYS][KEYS];
+static uint16_t estimates[KEYS][KEYS];
+
+// Key i is typed with a weight of 1 / (i + 1), as in Zipf's law.
+static uint8_t draw_key(uint32_t *seed) {
+    static double cumulative[KEYS];
+    if (cumulative[KEYS - 1] == 0) {
+        double sum = 0;
+        for (uint8_t i = 0; i < KEYS; i++) {
+            cumulative[i] = sum += 1.0 / (i + 1);
+        }
+    }
+    const double r = (double)bench_random(seed) / UINT32_MAX * cumulative[KEYS - 1];
+    uint8_t      i = 0;
+    while (i < KEYS - 1 && cumulative[i] < r) {
+        i++;
+    }
+    return i;
+}
+
+int main(void) {
+    uint32_t seed = 0x2545F491;
+    uint64_t cost = 0;
+    int      last = -1;
+
+    sim_init();
+    const uint8_t layer = __builtin_ctz(bigram_layers);
+    layer_move(layer);
+    for (unsigned i = 0; i < PRESSES; i++) {
+        const uint8_t key = draw_key(&seed);
+        const uint32_t r  = bench_random(&seed);
+        // Mostly typing, now and then a pause that starts over.
+        sim_set_time_us(sim_time_us() + 1000ULL * (r % 64 == 0 ? BIGRAM_IDLE + 500 : 20 + r % 200));
+
+        uint8_t row, col;
+        sim_layout_to_matrix(key, &row, &col);
+        keyrecord_t record = {.event = {.key = {.row = row, .col = col}, .type = KEY_EVENT, .pressed = true, .time = timer_read()}};
+
+        const uint64_t start = bench_now();
+        bigram_record(&record);
+        cost += bench_now() - start;
+
+        if (last >= 0 && r % 64 != 0) {
+            truth[last][key]++;
+        }
+        last = key;
+    }
+
+    uint64_t total = 0;
+    for (uint8_t a = 0; a < KEYS; a++) {
+        for (uint8_t b = 0; b < KEYS; b++) {
+            total += truth[a][b];
+        }
+    }
+    if (bigram_total() != total) {
+        fprintf(stderr, "%lu bigrams counted, %lu typed\n", (unsigned long)bigram_total(), (unsigned long)total);
+        return 1;
+    }
+
+    unsigned exact = 0, seen = 0;
+    uint32_t worst = 0;
+    uint64_t over  = 0;
+    for (uint8_t a = 0; a < KEYS; a++) {
+        for (uint8_t b = 0; b < KEYS; b++) {
+            estimates[a][b] = bigram_estimate(BIGRAM_ITEM(layer, a, b));
+            if (estimates[a][b] < truth[a][b]) {
+                fprintf(stderr, "bigram %u-%u: counted %u, typed %lu\n", a, b, estimates[a][b], (unsigned long)truth[a][b]);
+                return 1;
+            }
+            const uint32_t error = estimates[a][b] - truth[a][b];
+            exact += error == 0;
+            seen += truth[a][b] > 0;
+            over += error;
+            if (error > worst) {
+                worst = error;
+            }
+        }
+    }
+
+    // Past the save interval and the typing pause, then a reboot.
+    sim_run_until(sim_time_us() + 1000ULL * (BIGRAM_SAVE_INTERVAL + BIGRAM_SAVE_IDLE + 1000));
+    bigram_init();
+    for (uint8_t a = 0; a < KEYS; a++) {
+        for (uint8_t b = 0; b < KEYS; b++) {
+            if (bigram_estimate(BIGRAM_ITEM(layer, a, b)) != estimates[a][b]) {
+                fprintf(stderr, "bigram %u-%u: %u before saving, %u after loading\n", a, b, estimates[a][b], bigram_estimate(BIGRAM_ITEM(layer, a, b)));
+                return 1;
+            }
+        }
+    }
+
+    printf("bigram sketch, %u presses, %lu bigrams of %u pairs seen\n", PRESSES, (unsigned long)total, seen);
+    printf("  record      %6.1f %s per press\n", (double)cost / PRESSES, BENCH_UNIT);
+    printf("  exact       %6.1f%% of the %u pairs\n", 100.0 * exact / (KEYS * KEYS), KEYS * KEYS);
+    printf("  overcount   %6.1f on average, %lu at worst (%.2f%% of all bigrams)\n", (double)over / (KEYS * KEYS), (unsigned long)worst, 100.0 * worst / total);
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("bigram sketch: build with BIGRAM_ENABLE=yes\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,141 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Custom shift key lookup: the switch generated by CUSTOM_SHIFT_KEYS()
+// against the linear scan it replaced, for the keymap's table and for
+// synthetic tables of growing size. Half of the queries hit the table; the
+// other half miss, as most shifted presses (letters) do.
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "features/custom_shift_keys.h"
+
+#define QUERIES 4096
+#define ROUNDS 200
+
+// The scan process_custom_shift_keys() used to do.
+__attribute__((noinline)) static uint16_t linear_lookup(const custom_shift_key_t *table, uint8_t count, uint16_t keycode) {
+    for (int i = 0; i < count; ++i) {
+        if (keycode == table[i].keycode) {
+            return table[i].shifted_keycode;
+        }
+    }
+    return KC_NO;
+}
+
+// Synthetic tables: sparse keycodes across the 16-bit keycode space, as the
+// real table mixes basic, shifted and AltGr keycodes.
+#define KEY(i) (0x0104 + (i) * 0x0125)
+#define E8(X, b) X(KEY(b + 0), b + 1) X(KEY(b + 1), b + 2) X(KEY(b + 2), b + 3) X(KEY(b + 3), b + 4) X(KEY(b + 4), b + 5) X(KEY(b + 5), b + 6) X(KEY(b + 6), b + 7) X(KEY(b + 7), b + 8)
+#define TABLE_8(X) E8(X, 0)
+#define TABLE_16(X) TABLE_8(X) E8(X, 8)
+#define TABLE_32(X) TABLE_16(X) E8(X, 16) E8(X, 24)
+#define TABLE_64(X) TABLE_32(X) E8(X, 32) E8(X, 40) E8(X, 48) E8(X, 56)
+#define TABLE_128(X) TABLE_64(X) E8(X, 64) E8(X, 72) E8(X, 80) E8(X, 88) E8(X, 96) E8(X, 104) E8(X, 112) E8(X, 120)
+
+#define BENCH_TABLE(name, list)                                                     \
+    static const custom_shift_key_t name##_table[] = {list(CUSTOM_SHIFT_KEY_ENTRY_)}; \
+    __attribute__((noinline)) static uint16_t name##_lookup(uint16_t keycode) {     \
+        switch (keycode) {                                                          \
+            list(CUSTOM_SHIFT_KEY_CASE_) default : return KC_NO;                    \
+        }                                                                           \
+    }
+
+BENCH_TABLE(t8, TABLE_8)
+BENCH_TABLE(t16, TABLE_16)
+BENCH_TABLE(t32, TABLE_32)
+BENCH_TABLE(t64, TABLE_64)
+BENCH_TABLE(t128, TABLE_128)
+
+typedef struct {
+    const char               *name;
+    const custom_shift_key_t *table;
+    uint8_t                   count;
+    uint16_t (*lookup)(uint16_t keycode);
+} bench_table_t;
+
+static void make_queries(const bench_table_t *bench, uint16_t *queries) {
+    uint32_t seed = 0x2545F491;
+    for (int i = 0; i < QUERIES; i++) {
+        uint32_t r = bench_random(&seed);
+        if (r & 1) {
+            queries[i] = bench->table[(r >> 1) % bench->count].keycode;
+        } else {
+            do {
+                queries[i] = (uint16_t)(r >> 8);
+                r          = bench_random(&seed);
+            } while (bench->lookup(queries[i]) != KC_NO);
+        }
+    }
+}
+
+static double run_linear(const bench_table_t *bench, const uint16_t *queries) {
+    uint64_t best = UINT64_MAX;
+    for (int round = 0; round < ROUNDS; round++) {
+        uint64_t sum   = 0;
+        uint64_t start = bench_now();
+        for (int i = 0; i < QUERIES; i++) {
+            sum += linear_lookup(bench->table, bench->count, queries[i]);
+        }
+        uint64_t elapsed = bench_now() - start;
+        bench_consume(sum);
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return (double)best / QUERIES;
+}
+
+static double run_switch(const bench_table_t *bench, const uint16_t *queries) {
+    uint64_t best = UINT64_MAX;
+    for (int round = 0; round < ROUNDS; round++) {
+        uint64_t sum   = 0;
+        uint64_t start = bench_now();
+        for (int i = 0; i < QUERIES; i++) {
+            sum += bench->lookup(queries[i]);
+        }
+        uint64_t elapsed = bench_now() - start;
+        bench_consume(sum);
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return (double)best / QUERIES;
+}
+
+static bool check(const bench_table_t *bench, const uint16_t *queries) {
+    for (int i = 0; i < QUERIES; i++) {
+        if (linear_lookup(bench->table, bench->count, queries[i]) != bench->lookup(queries[i])) {
+            fprintf(stderr, "%s: lookup mismatch for keycode 0x%04X\n", bench->name, queries[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void) {
+    const bench_table_t benches[] = {
+        {"keymap", custom_shift_keys, NUM_CUSTOM_SHIFT_KEYS, custom_shift_key_lookup},
+        {"synthetic", t8_table, ARRAY_SIZE(t8_table), t8_lookup},
+        {"synthetic", t16_table, ARRAY_SIZE(t16_table), t16_lookup},
+        {"synthetic", t32_table, ARRAY_SIZE(t32_table), t32_lookup},
+        {"synthetic", t64_table, ARRAY_SIZE(t64_table), t64_lookup},
+        {"synthetic", t128_table, ARRAY_SIZE(t128_table), t128_lookup},
+    };
+    static uint16_t queries[QUERIES];
+
+    printf("custom shift key lookup, " BENCH_UNIT " per lookup (best of %d x %d)\n", ROUNDS, QUERIES);
+    printf("%-10s %7s %10s %10s %8s\n", "table", "entries", "linear", "switch", "speedup");
+    for (size_t i = 0; i < ARRAY_SIZE(benches); i++) {
+        const bench_table_t *bench = &benches[i];
+        make_queries(bench, queries);
+        if (!check(bench, queries)) {
+            return 1;
+        }
+        double linear = run_linear(bench, queries);
+        double lookup = run_switch(bench, queries);
+        printf("%-10s %7u %10.1f %10.1f %7.1fx\n", bench->name, bench->count, linear, lookup, linear / lookup);
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Expansion texts: time from the start of a text until the keyboard can
+// send its next report, on the simulated clock with a 1 ms polling
+// interval. send_string(), a press and a release report per character with
+// Shift toggled around capitals, is compared with a hid_batch.h batch. Both
+// must type the same text, and a batch must leave mods pressed meanwhile
+// down.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "features/expansions.h"
+#include "features/hid_batch.h"
+
+typedef struct {
+    unsigned reports;
+    uint64_t last_us;
+    FILE    *text;
+    sim_text_decoder_t decoder;
+} capture_t;
+
+static void capture_report(const sim_report_t *report, void *arg) {
+    capture_t *capture = arg;
+    capture->reports++;
+    capture->last_us = report->time_us;
+    sim_text_decode(&capture->decoder, report, capture->text);
+}
+
+static void send_batched(const char *string) {
+    hid_batch_begin();
+    while (*string) {
+        hid_batch_char(*string++, 0);
+    }
+    hid_batch_end();
+}
+
+// Runs one text and returns its duration in ms; the typed text goes to `text`.
+static double run(bool batched, const char *string, unsigned *reports, char *text, size_t size) {
+    capture_t capture = {0};
+    capture.text      = fmemopen(text, size, "w");
+    sim_set_time_us(sim_time_us() + 1000000);
+    sim_init();
+    sim_set_report_sink(capture_report, &capture);
+
+    const uint64_t start = sim_time_us();
+    if (batched) {
+        send_batched(string);
+    } else {
+        send_string(string);
+    }
+    sim_set_report_sink(NULL, NULL);
+    fclose(capture.text);
+    *reports = capture.reports;
+    return (double)(capture.last_us + 1000 - start) / 1000.0;
+}
+
+// A mod pressed while a batch runs, as a tap-hold key settling as a hold
+// between two reports of a queued macro, is still down after it; Shift held
+// before the batch comes back.
+static bool keeps_user_mods(void) {
+    sim_init();
+    register_mods(MOD_BIT(KC_LSFT));
+    hid_batch_begin();
+    hid_batch_char('a', 0);
+    hid_batch_send();
+    register_mods(MOD_BIT(KC_LCTL));
+    hid_batch_char('b', 0);
+    hid_batch_end();
+    const uint8_t mods = get_mods();
+    clear_mods();
+    return mods == (MOD_BIT(KC_LSFT) | MOD_BIT(KC_LCTL));
+}
+
+int main(void) {
+    if (!keeps_user_mods()) {
+        fprintf(stderr, "a mod pressed during a batch was released by hid_batch_end()\n");
+        return 1;
+    }
+
+    // The keymap's ASCII expansions, plus a repeated letter and a full report.
+    const char *extra[] = {"ll", "See", "abcdefgh"};
+    double      old_total = 0;
+    double      new_total = 0;
+    unsigned    count     = 0;
+
+    printf("expansion texts, ms until the next report can go out\n");
+    printf("%-10s %12s %12s\n", "text", "send_string", "batched");
+    for (unsigned i = 0; i < NUM_EXPANSIONS * EXPANSION_CASES + ARRAY_SIZE(extra); i++) {
+        char string[EXPANSION_LENGTH + 1] = {0};
+        const char *source = string;
+        if (i < NUM_EXPANSIONS * EXPANSION_CASES) {
+            memcpy(string, expansions[i / EXPANSION_CASES].text[i % EXPANSION_CASES], EXPANSION_LENGTH);
+            // Texts with Unicode glyphs are left to bench/unicode.c.
+            bool glyph = false;
+            for (const char *c = string; *c; c++) {
+                glyph |= (*c & 0x80) != 0;
+            }
+            if (glyph) {
+                continue;
+            }
+        } else {
+            source = extra[i - NUM_EXPANSIONS * EXPANSION_CASES];
+        }
+        char     old_text[64] = {0}, new_text[64] = {0};
+        unsigned old_reports, new_reports;
+        double   old_ms = run(false, source, &old_reports, old_text, sizeof(old_text));
+        double   new_ms = run(true, source, &new_reports, new_text, sizeof(new_text));
+        if (strcmp(old_text, new_text) != 0) {
+            fprintf(stderr, "\"%s\": typed \"%s\", expected \"%s\"\n", source, new_text, old_text);
+            return 1;
+        }
+        printf("%-10s %6.0f (%2u) %6.0f (%2u)\n", source, old_ms, old_reports, new_ms, new_reports);
+        old_total += old_ms;
+        new_total += new_ms;
+        count++;
+    }
+    printf("mean ms/text: send_string %.1f, batched %.1f (reports in parentheses)\n", old_total / count, new_total / count);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Key history: cost of recording a keystroke and of each query, with random
+// words typed and partly erased. The word hash must always match the hash of
+// the letters left, and the queries must not depend on how much was typed.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "features/key_history.h"
+
+#define KEYSTROKES 200000
+
+typedef struct {
+    const char *name;
+    uint64_t    total;
+    uint64_t    count;
+} cost_t;
+
+static void add_cost(cost_t *cost, uint64_t start) {
+    cost->total += bench_now() - start;
+    cost->count++;
+}
+
+int main(void) {
+    cost_t   record = {.name = "record"}, keycode = {.name = "keycode"}, since = {.name = "since"}, hash = {.name = "word hash"};
+    uint16_t letters[KEY_HISTORY_WORD_MAX];
+    uint8_t  length = 0;
+    uint32_t seed   = 0x2545F491;
+
+    sim_init();
+    key_history_init();
+    for (unsigned i = 0; i < KEYSTROKES; i++) {
+        const uint32_t r = bench_random(&seed);
+        uint16_t       key;
+        if (r % 8 == 0) {
+            key = KC_SPC;
+        } else if (r % 8 == 1 && length > 0) {
+            key = KC_BSPC;
+        } else if (length < KEY_HISTORY_WORD_MAX) {
+            key = KC_A + (r >> 8) % 26;
+        } else {
+            key = KC_SPC;
+        }
+        keyrecord_t       kr    = {.event = {.key = {0, 0}, .type = KEY_EVENT, .pressed = true, .time = timer_read()}};
+        const key_event_t event = key_event_snapshot(key, &kr);
+
+        uint64_t start = bench_now();
+        key_history_record(&event, &kr);
+        add_cost(&record, start);
+
+        if (key == KC_SPC) {
+            length = 0;
+        } else if (key == KC_BSPC) {
+            length--;
+        } else {
+            letters[length++] = key;
+        }
+
+        start = bench_now();
+        bench_consume(key_history_keycode(3));
+        add_cost(&keycode, start);
+        start = bench_now();
+        bench_consume(key_history_since(KC_Z));
+        add_cost(&since, start);
+        start = bench_now();
+        const uint16_t word = key_history_word_hash();
+        add_cost(&hash, start);
+
+        if (key_history_keycode(0) != key || word != key_history_hash(letters, length) || key_history_word_length() != length) {
+            fprintf(stderr, "keystroke %u: history out of step with the %u letters typed\n", i, length);
+            return 1;
+        }
+        sim_set_time_us(sim_time_us() + 1000 * (20 + (r >> 16) % 200));
+    }
+
+    printf("key history, %s per call over %u keystrokes\n", BENCH_UNIT, KEYSTROKES);
+    const cost_t *costs[] = {&record, &keycode, &since, &hash};
+    for (size_t i = 0; i < ARRAY_SIZE(costs); i++) {
+        printf("  %-10s %6.1f\n", costs[i]->name, (double)costs[i]->total / costs[i]->count);
+    }
+    return 0;
+}
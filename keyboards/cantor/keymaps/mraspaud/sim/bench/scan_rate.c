@@ -0,0 +1,166 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Scan rate schedule: replays key timelines through a modelled main loop,
+// where each scan takes SCAN_US and is followed by scan_rate_pause(), and
+// checks when each key change is seen and which mode the loop is in. Changes
+// during a burst must be seen by the next scan, the first one after idling
+// within one idle pause, and the modes must follow the tail and idle
+// timeout after the last change.
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "features/scan_rate.h"
+
+// A scan and the rest of the keyboard task, about what the firmware takes.
+#define SCAN_US 250
+
+#define MS 1000ULL
+
+// How far off the mode may change: the last change is seen up to one scan
+// late, and timer_read32() counts whole milliseconds, either way.
+#define LATE_US (SCAN_US + MS)
+#define EARLY_US MS
+
+typedef struct {
+    uint64_t time_us;
+    uint8_t  position;
+    bool     pressed;
+} change_t;
+
+typedef struct {
+    const char *name;
+    change_t    changes[64];
+    uint8_t     count;
+    uint64_t    end_us;
+} timeline_t;
+
+typedef struct {
+    uint64_t scans[3];
+    uint64_t time_us[3];
+    uint64_t first_latency_us;  // Of the first change, seen from idle.
+    uint64_t max_latency_us;    // Of the others.
+} run_t;
+
+static const char *const mode_names[] = {"burst", "active", "idle"};
+
+// Typing: a key every 120 ms for two seconds, each held 60 ms, after the
+// board sat idle for ten seconds.
+static void typing(timeline_t *timeline) {
+    timeline->name  = "typing";
+    timeline->count = 0;
+    for (uint8_t i = 0; i < 16; i++) {
+        // Off the scan grid, so that changes wait for their scan.
+        const uint64_t t   = 10000 * MS + i * 120 * MS + (i % 3) * 7 * MS + i * 37;
+        const uint8_t  key = i % 2 ? 19 : 16;  // a, t
+        timeline->changes[timeline->count++] = (change_t){t, key, true};
+        timeline->changes[timeline->count++] = (change_t){t + 60 * MS, key, false};
+    }
+    timeline->end_us = 30000 * MS;
+}
+
+// A key held for twenty seconds: no pause until it is released.
+static void holding(timeline_t *timeline) {
+    timeline->name       = "holding";
+    timeline->count      = 2;
+    timeline->changes[0] = (change_t){10000 * MS + 1300, 16, true};
+    timeline->changes[1] = (change_t){30000 * MS, 16, false};
+    timeline->end_us     = 40000 * MS;
+}
+
+static bool check(bool condition, const char *name, uint64_t t, const char *what) {
+    if (!condition) {
+        fprintf(stderr, "%s at %llu ms: %s\n", name, (unsigned long long)(t / MS), what);
+    }
+    return condition;
+}
+
+// After the last change, the mode must be the one the schedule gives; around
+// each switch, either of the two.
+static bool check_tail(const timeline_t *timeline, uint64_t t, scan_rate_mode_t mode) {
+    const uint64_t since = t - timeline->changes[timeline->count - 1].time_us;
+    const uint64_t tail  = SCAN_RATE_TAIL * MS;
+    const uint64_t idle  = SCAN_RATE_IDLE_TIMEOUT * MS;
+    if (since + EARLY_US < tail) {
+        return check(mode == SCAN_RATE_BURST, timeline->name, t, "not bursting in the tail");
+    }
+    if (since < tail + LATE_US) {
+        return check(mode != SCAN_RATE_IDLE, timeline->name, t, "idle in the tail");
+    }
+    if (since + EARLY_US < idle) {
+        return check(mode == SCAN_RATE_ACTIVE, timeline->name, t, "not active between the tail and the timeout");
+    }
+    if (since < idle + LATE_US) {
+        return check(mode != SCAN_RATE_BURST, timeline->name, t, "bursting at the timeout");
+    }
+    return check(mode == SCAN_RATE_IDLE, timeline->name, t, "not idle after the timeout");
+}
+
+static bool run(const timeline_t *timeline, run_t *result) {
+    uint64_t t    = 0;
+    uint8_t  next = 0;
+    bool     ok   = true;
+
+    *result = (run_t){0};
+    sim_init();
+    while (t < timeline->end_us) {
+        sim_run_until(t);
+        while (next < timeline->count && timeline->changes[next].time_us <= t) {
+            const change_t *change  = &timeline->changes[next];
+            const uint64_t  latency = t - change->time_us;
+            uint8_t         row, col;
+            sim_layout_to_matrix(change->position, &row, &col);
+            sim_key_event(row, col, change->pressed);
+            if (next == 0) {
+                result->first_latency_us = latency;
+            } else if (latency > result->max_latency_us) {
+                result->max_latency_us = latency;
+            }
+            next++;
+        }
+        const scan_rate_mode_t mode  = scan_rate_mode();
+        const uint64_t         pause = scan_rate_pause();
+        if (next == timeline->count) {
+            ok = check_tail(timeline, t, mode) && ok;
+        } else if (next > 0 && timeline->changes[next - 1].pressed) {
+            ok = check(mode == SCAN_RATE_BURST, timeline->name, t, "pausing with a key held") && ok;
+        }
+        result->scans[mode]++;
+        result->time_us[mode] += SCAN_US + pause;
+        t += SCAN_US + pause;
+    }
+    ok = check(result->first_latency_us <= SCAN_RATE_IDLE_PAUSE + SCAN_US, timeline->name, timeline->changes[0].time_us, "first change seen late") && ok;
+    ok = check(result->max_latency_us <= SCAN_US, timeline->name, timeline->changes[0].time_us, "change seen late in a burst") && ok;
+    return ok;
+}
+
+int main(void) {
+    timeline_t timeline;
+    run_t      result;
+    bool       ok = true;
+    void (*const timelines[])(timeline_t *) = {typing, holding};
+
+    printf("scan_rate: modelled loop, %u us per scan; tail %u ms, idle after %u ms\n", SCAN_US, SCAN_RATE_TAIL, SCAN_RATE_IDLE_TIMEOUT);
+    for (size_t i = 0; i < ARRAY_SIZE(timelines); i++) {
+        timelines[i](&timeline);
+        if (!run(&timeline, &result)) {
+            ok = false;
+            continue;
+        }
+        uint64_t scans = 0;
+        for (uint8_t mode = 0; mode < 3; mode++) {
+            scans += result.scans[mode];
+        }
+        printf("%s: %llu scans in %llu s (%llu at full rate); first change seen after %llu us, others within %llu us\n", timeline.name, (unsigned long long)scans,
+               (unsigned long long)(timeline.end_us / 1000000), (unsigned long long)(timeline.end_us / SCAN_US), (unsigned long long)result.first_latency_us,
+               (unsigned long long)result.max_latency_us);
+        for (uint8_t mode = 0; mode < 3; mode++) {
+            if (result.time_us[mode] > 0) {
+                printf("  %-7s %8llu scans  %6.0f /s  %8.1f s\n", mode_names[mode], (unsigned long long)result.scans[mode], result.scans[mode] * 1e6 / result.time_us[mode],
+                       result.time_us[mode] / 1e6);
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
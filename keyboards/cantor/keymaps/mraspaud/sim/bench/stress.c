@@ -0,0 +1,205 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Worst-case event streams: random rollover over small sets of keys, with
+// several keys down at once, released in any order and arriving 50 us to
+// 1.5 ms apart, faster than the host polls. Each scenario is a series of
+// bursts; after each burst every key is up and the keyboard is left alone
+// until its timers have run out, and then the host must see no key and no
+// mod down, every key it saw pressed must have been released, the keymap
+// must hold no mods, and no momentary layer may be left on.
+//
+// The cost of every key event and of the timer work between events is
+// recorded, and reported as mean, 99th percentile and maximum.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define BURSTS 400
+#define PRESSES_PER_BURST 40
+#define SETTLE_US 6000000
+#define MAX_SAMPLES (BURSTS * PRESSES_PER_BURST * 2 + BURSTS * 4)
+
+typedef struct {
+    const char    *name;
+    const uint8_t *keys;  // Layout indices.
+    uint8_t        count;
+    uint8_t        max_down;
+    uint32_t       min_gap_us;
+    uint32_t       max_gap_us;
+} scenario_t;
+
+// Home row mod-taps rolled with the letters around them (and the ct and ai
+// combos).
+static const uint8_t home_row[] = {13, 15, 20, 22, 14, 16, 19, 21, 3, 31, 32, 28};
+// S+E to the Swedish layer, where / and þ are tap dances (ä/æ, ö/ø) sharing
+// keys with the backspace and delete combos; R for the symbol layer and its
+// €/£ tap dance.
+static const uint8_t tap_dances[] = {13, 20, 8, 9, 10, 34, 37, 26, 19};
+// (+) for Caps Word, þ (DI_TH) and q (qu) typed under it, with shift held.
+static const uint8_t caps_word[] = {12, 23, 34, 36, 19, 20, 15, 16};
+// F+R, S+E, N+E and P+L+D, the TO() combos, in any order.
+static const uint8_t layer_flips[] = {25, 37, 13, 20, 15, 26, 27, 28, 8};
+// Custom shift keys with both shifts, faster still.
+static const uint8_t custom_shift[] = {15, 20, 7, 18, 6, 39, 12, 23, 41};
+
+static const scenario_t scenarios[] = {
+    {"home row rollover", home_row, ARRAY_SIZE(home_row), 4, 200, 1500},
+    {"combos and tap dances", tap_dances, ARRAY_SIZE(tap_dances), 3, 200, 1500},
+    {"caps word and digraphs", caps_word, ARRAY_SIZE(caps_word), 3, 200, 1500},
+    {"layer flips", layer_flips, ARRAY_SIZE(layer_flips), 4, 200, 1500},
+    {"custom shift keys", custom_shift, ARRAY_SIZE(custom_shift), 3, 50, 600},
+};
+
+// What the host has seen.
+typedef struct {
+    report_keyboard_t last;
+    uint64_t          presses;
+    uint64_t          releases;
+} host_t;
+
+static void track_report(const sim_report_t *report, void *arg) {
+    host_t *host = arg;
+    if (report->type != SIM_REPORT_KEYBOARD) {
+        return;
+    }
+    const report_keyboard_t *now = &report->keyboard;
+    for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (now->keys[i] && memchr(host->last.keys, now->keys[i], KEYBOARD_REPORT_KEYS) == NULL) {
+            host->presses++;
+        }
+        if (host->last.keys[i] && memchr(now->keys, host->last.keys[i], KEYBOARD_REPORT_KEYS) == NULL) {
+            host->releases++;
+        }
+    }
+    host->presses += __builtin_popcount(now->mods & ~host->last.mods);
+    host->releases += __builtin_popcount(host->last.mods & ~now->mods);
+    host->last = *now;
+}
+
+typedef struct {
+    uint64_t *samples;
+    size_t    count;
+} costs_t;
+
+static int compare_costs(const void *a, const void *b) {
+    const uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void print_costs(const char *what, costs_t *costs) {
+    if (costs->count == 0) {
+        return;
+    }
+    qsort(costs->samples, costs->count, sizeof(uint64_t), compare_costs);
+    uint64_t total = 0;
+    for (size_t i = 0; i < costs->count; i++) {
+        total += costs->samples[i];
+    }
+    printf("  %-7s %7zu  mean %7.0f  p99 %7llu  max %8llu %s\n", what, costs->count, (double)total / costs->count,
+           (unsigned long long)costs->samples[costs->count * 99 / 100], (unsigned long long)costs->samples[costs->count - 1], BENCH_UNIT);
+}
+
+static void key_event(uint8_t index, bool pressed, costs_t *costs) {
+    uint8_t row, col;
+    sim_layout_to_matrix(index, &row, &col);
+    const uint64_t start = bench_now();
+    sim_key_event(row, col, pressed);
+    costs->samples[costs->count++] = bench_now() - start;
+}
+
+static void run_timers_until(uint64_t t, costs_t *costs) {
+    const uint64_t start = bench_now();
+    sim_run_until(t);
+    costs->samples[costs->count++] = bench_now() - start;
+}
+
+// Checks the keyboard at rest; returns false after printing what is wrong.
+static bool check_idle(const scenario_t *scenario, unsigned burst, const host_t *host) {
+    static const report_keyboard_t empty = {0};
+    const uint8_t                  layer = get_highest_layer(layer_state | default_layer_state);
+    const char                    *wrong = NULL;
+    if (memcmp(&host->last, &empty, sizeof(empty)) != 0) {
+        wrong = "keys or mods still down on the host";
+    } else if (host->presses != host->releases) {
+        wrong = "presses and releases do not match";
+    } else if (get_mods() || get_weak_mods() || get_oneshot_mods()) {
+        wrong = "mods left on in the keymap";
+    } else if (layer != 0 && layer != 1 && layer != 2 && layer != 3 && layer != 4) {
+        wrong = "a momentary layer left on";
+    }
+    if (wrong == NULL) {
+        return true;
+    }
+    fprintf(stderr, "%s, burst %u: %s (report mods %02X keys %02X %02X %02X %02X %02X %02X, %llu presses, %llu releases, mods %02X/%02X/%02X, layer %u)\n",
+            scenario->name, burst, wrong, host->last.mods, host->last.keys[0], host->last.keys[1], host->last.keys[2], host->last.keys[3], host->last.keys[4],
+            host->last.keys[5], (unsigned long long)host->presses, (unsigned long long)host->releases, get_mods(), get_weak_mods(), get_oneshot_mods(), layer);
+    return false;
+}
+
+static bool run(const scenario_t *scenario, costs_t *events, costs_t *timers) {
+    host_t   host = {0};
+    uint32_t seed = 0x2545F491;
+    sim_set_time_us(sim_time_us() + 1000000);
+    sim_init();
+    sim_set_usb_interval_us(0);
+    sim_set_report_sink(track_report, &host);
+
+    for (unsigned burst = 0; burst < BURSTS; burst++) {
+        uint8_t  down[SIM_LAYOUT_KEYS];
+        uint8_t  down_count = 0;
+        unsigned presses    = 0;
+        while (presses < PRESSES_PER_BURST || down_count > 0) {
+            const uint32_t r    = bench_random(&seed);
+            const bool     more = presses < PRESSES_PER_BURST && down_count < scenario->max_down;
+            if (more && (down_count == 0 || (r & 3) != 0)) {
+                const uint8_t key = scenario->keys[(r >> 2) % scenario->count];
+                if (memchr(down, key, down_count) != NULL) {
+                    continue;
+                }
+                down[down_count++] = key;
+                presses++;
+                key_event(key, true, events);
+            } else {
+                const uint8_t slot = (r >> 2) % down_count;
+                const uint8_t key  = down[slot];
+                down[slot]         = down[--down_count];
+                key_event(key, false, events);
+            }
+            const uint32_t gap = scenario->min_gap_us + bench_random(&seed) % (scenario->max_gap_us - scenario->min_gap_us + 1);
+            run_timers_until(sim_time_us() + gap, timers);
+        }
+        run_timers_until(sim_time_us() + SETTLE_US, timers);
+        if (!check_idle(scenario, burst, &host)) {
+            sim_set_report_sink(NULL, NULL);
+            return false;
+        }
+    }
+    sim_set_report_sink(NULL, NULL);
+    sim_set_usb_interval_us(1000);
+    return true;
+}
+
+int main(void) {
+    costs_t events = {malloc(MAX_SAMPLES * sizeof(uint64_t)), 0};
+    costs_t timers = {malloc(MAX_SAMPLES * sizeof(uint64_t)), 0};
+    bool    ok     = true;
+
+    printf("stress: %u bursts of %u presses per scenario, cost per key event and per timer run\n", BURSTS, PRESSES_PER_BURST);
+    for (size_t i = 0; i < ARRAY_SIZE(scenarios); i++) {
+        events.count = 0;
+        timers.count = 0;
+        if (!run(&scenarios[i], &events, &timers)) {
+            ok = false;
+            continue;
+        }
+        printf("%s: no stuck keys or mods\n", scenarios[i].name);
+        print_costs("events", &events);
+        print_costs("timers", &timers);
+    }
+    free(events.samples);
+    free(timers.samples);
+    return ok ? 0 : 1;
+}
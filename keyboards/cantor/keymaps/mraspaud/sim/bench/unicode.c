@@ -0,0 +1,106 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Unicode glyphs: time from the start of a glyph until the keyboard can send
+// its next report, on the simulated clock with a 1 ms polling interval, and
+// how long of it the main loop is held up. The precomputed sequences of the
+// keymap's table, queued on output_queue.h, are compared with the
+// send_unicode_string() path they replaced, as configured before
+// (UNICODE_TYPE_DELAY 10), which blocks throughout. Both must type the same
+// text.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "features/unicode_sequences.h"
+
+#define OLD_TYPE_DELAY 10
+
+typedef struct {
+    unsigned reports;
+    uint64_t last_us;
+    FILE    *text;
+    sim_text_decoder_t decoder;
+} capture_t;
+
+static void capture_report(const sim_report_t *report, void *arg) {
+    capture_t *capture = arg;
+    capture->reports++;
+    capture->last_us = report->time_us;
+    sim_text_decode(&capture->decoder, report, capture->text);
+}
+
+// What QMK's register_unicode() did for each glyph.
+static void send_runtime(uint32_t code_point) {
+    const uint8_t saved_mods = get_mods();
+    clear_mods();
+    clear_weak_mods();
+    tap_code16(UNICODE_KEY_LNX);
+    wait_ms(OLD_TYPE_DELAY);
+    register_hex32(code_point);
+    tap_code(KC_SPC);
+    set_mods(saved_mods);
+}
+
+static uint32_t code_point_of(const unicode_sequence_t *sequence) {
+    uint32_t code_point = 0;
+    for (uint8_t i = sequence->first; i < UNICODE_SEQUENCE_DIGITS; i++) {
+        const uint8_t key = sequence->digits[i];
+        code_point        = code_point * 16 + (key <= KC_F ? key - KC_A + 10 : key == KC_0 ? 0 : key - KC_1 + 1);
+    }
+    return code_point;
+}
+
+// Runs one glyph and returns its duration in ms, with the time the call
+// blocked in `blocked_ms`; the typed text goes to `text`.
+static double run(bool precomputed, uint8_t index, unsigned *reports, double *blocked_ms, char *text, size_t size) {
+    capture_t capture = {0};
+    capture.text      = fmemopen(text, size, "w");
+    sim_set_time_us(sim_time_us() + 1000000);
+    sim_init();
+    sim_set_report_sink(capture_report, &capture);
+
+    const uint64_t start = sim_time_us();
+    if (precomputed) {
+        send_unicode_sequence(index);
+    } else {
+        send_runtime(code_point_of(&unicode_sequences[index]));
+    }
+    // The first report goes out from the call, the rest from the timers.
+    *blocked_ms = (double)(sim_time_us() + 1000 - start) / 1000.0;
+    sim_run_until(sim_time_us() + 1000000);
+    sim_set_report_sink(NULL, NULL);
+    fclose(capture.text);
+    *reports = capture.reports;
+    return (double)(capture.last_us + 1000 - start) / 1000.0;
+}
+
+int main(void) {
+    double   old_total   = 0;
+    double   new_total   = 0;
+    double   new_blocked = 0;
+    unsigned count       = 0;
+
+    printf("unicode glyphs, ms until the next report can go out\n");
+    printf("%-8s %12s %12s %8s\n", "glyph", "runtime", "precomputed", "blocking");
+    for (uint8_t i = 0; i < NUM_UNICODE_SEQUENCES; i++) {
+        char     old_text[64] = {0}, new_text[64] = {0};
+        unsigned old_reports, new_reports;
+        double   old_blocked_ms, new_blocked_ms;
+        double   old_ms = run(false, i, &old_reports, &old_blocked_ms, old_text, sizeof(old_text));
+        double   new_ms = run(true, i, &new_reports, &new_blocked_ms, new_text, sizeof(new_text));
+        if (strcmp(old_text, new_text) != 0) {
+            fprintf(stderr, "glyph %u: typed \"%s\", expected \"%s\"\n", i, new_text, old_text);
+            return 1;
+        }
+        const unicode_sequence_t *sequence = &unicode_sequences[i];
+        printf("U+%04X %6.0f (%2u) %6.0f (%2u) %8.0f  %s\n", code_point_of(sequence), old_ms, old_reports, new_ms, new_reports, new_blocked_ms, new_text);
+        old_total += old_ms;
+        new_total += new_ms;
+        new_blocked += new_blocked_ms;
+        count++;
+    }
+    printf("mean ms/glyph: runtime %.1f, precomputed %.1f, blocking %.1f (reports in parentheses)\n", old_total / count, new_total / count, new_blocked / count);
+    return 0;
+}
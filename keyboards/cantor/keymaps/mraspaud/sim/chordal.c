@@ -0,0 +1,92 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Chordal hold compiler: turns finger_model in keymap.c, which lists keys in
+// LAYOUT_split_3x6_3 order, into the bit matrix get_chordal_hold() reads by
+// matrix position: one entry per key held, at its row and column, and one
+// bit per key pressed after it, numbered row * MATRIX_COLS + column.
+//
+// A tap-hold key pressed, then another key before it settled, may be held
+// only when the two could not have been rolled:
+//
+//     thumb key held          always: layer-taps under any key
+//     thumb key pressed       always: a mod on a thumb key (Shift+Space,
+//                             Shift+R), as the thumbs are shared by both
+//                             hands
+//     other hand              always: a mod and its key
+//     same finger             always: the finger on the mod cannot have
+//                             pressed the other key, so another did on
+//                             purpose (Ctrl+F on the S pinky)
+//     other finger, same hand never: rolls like "sc", "st", "nt"
+//
+// The output is the header keymap.c includes; `make check` fails when the
+// committed one is stale:
+//
+//     ./chordal > ../chordal_hold.h
+
+#include <stdio.h>
+
+#include "features/finger_model.h"
+#include "sim.h"
+
+static bool may_hold(const finger_key_t *tap_hold, const finger_key_t *other) {
+    if (finger_is_thumb(tap_hold->finger) || finger_is_thumb(other->finger)) {
+        return true;
+    }
+    if (finger_is_left(tap_hold->finger) != finger_is_left(other->finger)) {
+        return true;
+    }
+    return tap_hold->finger == other->finger;
+}
+
+static const char *const finger_names[] = {
+    "left pinky", "left ring", "left middle", "left index", "left thumb", "right thumb", "right index", "right middle", "right ring", "right pinky",
+};
+
+_Static_assert(ARRAY_SIZE(finger_names) == FINGER_RIGHT_PINKY + 1, "one name per finger");
+_Static_assert(MATRIX_ROWS * MATRIX_COLS <= 64, "entries are two 32-bit words");
+_Static_assert(FINGER_MODEL_KEYS == SIM_LAYOUT_KEYS, "one finger_model entry per LAYOUT key");
+
+int main(void) {
+    uint32_t matrix[MATRIX_ROWS][MATRIX_COLS][2] = {0};
+    bool     in_layout[MATRIX_ROWS][MATRIX_COLS] = {0};
+    uint8_t  rows[FINGER_MODEL_KEYS], cols[FINGER_MODEL_KEYS];
+    for (uint8_t k = 0; k < FINGER_MODEL_KEYS; k++) {
+        sim_layout_to_matrix(k, &rows[k], &cols[k]);
+        in_layout[rows[k]][cols[k]] = true;
+    }
+    for (uint8_t t = 0; t < FINGER_MODEL_KEYS; t++) {
+        for (uint8_t o = 0; o < FINGER_MODEL_KEYS; o++) {
+            const uint8_t bit = rows[o] * MATRIX_COLS + cols[o];
+            if (may_hold(&finger_model[t], &finger_model[o])) {
+                matrix[rows[t]][cols[t]][bit >> 5] |= (uint32_t)1 << (bit & 31);
+            }
+        }
+    }
+
+    printf("// Generated by sim/chordal from finger_model in keymap.c; do not edit.\n");
+    printf("//\n");
+    printf("// Entry [row][col], bit o: the tap-hold key at matrix row, col may be held\n");
+    printf("// when the key at row * MATRIX_COLS + col = o is pressed. Bits 0-31 are in\n");
+    printf("// the first word, 32-%d in the second.\n", MATRIX_ROWS * MATRIX_COLS - 1);
+    printf("\n");
+    printf("#pragma once\n");
+    printf("\n");
+    printf("#define CHORDAL_HOLD_MATRIX { \\\n");
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        printf("    { \\\n");
+        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
+            printf("        {0x%08x, 0x%08x},", matrix[r][c][0], matrix[r][c][1]);
+            if (in_layout[r][c]) {
+                const uint8_t       k   = sim_matrix_to_layout(r, c);
+                const finger_key_t *key = &finger_model[k];
+                printf("  /* %u,%u: LAYOUT %2u, %s, row %u, column %u */ \\\n", r, c, k, finger_names[key->finger], key->row, key->col);
+            } else {
+                printf("  /* %u,%u: no key */ \\\n", r, c);
+            }
+        }
+        printf("    }, \\\n");
+    }
+    printf("}\n");
+    return 0;
+}
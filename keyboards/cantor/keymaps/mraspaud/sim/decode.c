@@ -0,0 +1,174 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Host-side decoding of keyboard reports into text, as typed on a Linux
+// desktop with the EurKEY layout and IBus Ctrl+Shift+U Unicode entry.
+
+#include "sim.h"
+
+enum { UNICODE_IDLE, UNICODE_HEX };
+
+typedef struct {
+    uint8_t     keycode;
+    const char *plain;
+    const char *shifted;
+    const char *altgr;
+    const char *altgr_shifted;
+} glyph_t;
+
+// clang-format off
+static const glyph_t glyphs[] = {
+    {KC_A, "a", "A", "ä", "Ä"}, {KC_B, "b", "B", "í", "Í"}, {KC_C, "c", "C", "ç", "Ç"},
+    {KC_D, "d", "D", "ð", "Ð"}, {KC_E, "e", "E", "ë", "Ë"}, {KC_F, "f", "F", "è", "È"},
+    {KC_G, "g", "G", "é", "É"}, {KC_H, "h", "H", "ù", "Ù"}, {KC_I, "i", "I", "ï", "Ï"},
+    {KC_J, "j", "J", "ú", "Ú"}, {KC_K, "k", "K", "ĳ", "Ĳ"}, {KC_L, "l", "L", "ø", "Ø"},
+    {KC_M, "m", "M", "<greek>", "<greek>"}, {KC_N, "n", "N", "ñ", "Ñ"}, {KC_O, "o", "O", "ö", "Ö"},
+    {KC_P, "p", "P", "œ", "Œ"}, {KC_Q, "q", "Q", "æ", "Æ"}, {KC_R, "r", "R", "ÿ", "Ÿ"},
+    {KC_S, "s", "S", "ß", "ẞ"}, {KC_T, "t", "T", "þ", "Þ"}, {KC_U, "u", "U", "?", "?"},
+    {KC_V, "v", "V", "ì", "Ì"}, {KC_W, "w", "W", "å", "Å"}, {KC_X, "x", "X", "á", "Á"},
+    {KC_Y, "y", "Y", "ü", "Ü"}, {KC_Z, "z", "Z", "à", "À"},
+    {KC_1, "1", "!", "¡", "¹"}, {KC_2, "2", "@", "ª", "²"}, {KC_3, "3", "#", "º", "§"},
+    {KC_4, "4", "$", "£", "¥"}, {KC_5, "5", "%", "€", "¢"}, {KC_6, "6", "^", "^", "ˇ"},
+    {KC_7, "7", "&", "˚", "¯"}, {KC_8, "8", "*", "„", "‚"}, {KC_9, "9", "(", "“", "‘"},
+    {KC_0, "0", ")", "”", "’"}, {KC_MINS, "-", "_", "–", "—"}, {KC_EQL, "=", "+", "×", "÷"},
+    {KC_LBRC, "[", "{", "«", "‹"}, {KC_RBRC, "]", "}", "»", "›"}, {KC_BSLS, "\\", "|", "¬", "¦"},
+    {KC_SCLN, ";", ":", "°", "?"}, {KC_QUOT, "'", "\"", "´", "¨"}, {KC_GRV, "`", "~", "`", "~"},
+    {KC_COMM, ",", "<", "‘", "·"}, {KC_DOT, ".", ">", "’", "…"}, {KC_SLSH, "/", "?", "¿", "ˀ"},
+    {KC_SPC, " ", " ", " ", " "},
+};
+// clang-format on
+
+static const char *key_name(uint8_t keycode) {
+    switch (keycode) {
+        case KC_ENT:
+            return "\n";
+        case KC_TAB:
+            return "<tab>";
+        case KC_BSPC:
+            return "<bspc>";
+        case KC_DEL:
+            return "<del>";
+        case KC_ESC:
+            return "<esc>";
+        case KC_LEFT:
+            return "<left>";
+        case KC_RGHT:
+            return "<right>";
+        case KC_UP:
+            return "<up>";
+        case KC_DOWN:
+            return "<down>";
+        case KC_HOME:
+            return "<home>";
+        case KC_END:
+            return "<end>";
+        case KC_PGUP:
+            return "<pgup>";
+        case KC_PGDN:
+            return "<pgdn>";
+        case KC_PSCR:
+            return "<prtscr>";
+        default:
+            return NULL;
+    }
+}
+
+static const glyph_t *find_glyph(uint8_t keycode) {
+    for (size_t i = 0; i < ARRAY_SIZE(glyphs); i++) {
+        if (glyphs[i].keycode == keycode) {
+            return &glyphs[i];
+        }
+    }
+    return NULL;
+}
+
+static void put_utf8(uint32_t cp, FILE *out) {
+    if (cp < 0x80) {
+        fputc(cp, out);
+    } else if (cp < 0x800) {
+        fputc(0xC0 | (cp >> 6), out);
+        fputc(0x80 | (cp & 0x3F), out);
+    } else if (cp < 0x10000) {
+        fputc(0xE0 | (cp >> 12), out);
+        fputc(0x80 | ((cp >> 6) & 0x3F), out);
+        fputc(0x80 | (cp & 0x3F), out);
+    } else {
+        fputc(0xF0 | (cp >> 18), out);
+        fputc(0x80 | ((cp >> 12) & 0x3F), out);
+        fputc(0x80 | ((cp >> 6) & 0x3F), out);
+        fputc(0x80 | (cp & 0x3F), out);
+    }
+}
+
+static int hex_digit(uint8_t keycode) {
+    if (keycode >= KC_A && keycode <= KC_F) {
+        return 10 + keycode - KC_A;
+    }
+    if (keycode >= KC_1 && keycode <= KC_9) {
+        return 1 + keycode - KC_1;
+    }
+    if (keycode == KC_0) {
+        return 0;
+    }
+    return -1;
+}
+
+static void decode_press(sim_text_decoder_t *decoder, uint8_t keycode, uint8_t mods, FILE *out) {
+    const bool shift = mods & MOD_MASK_SHIFT;
+    const bool altgr = mods & MOD_BIT(KC_RALT);
+    const bool ctrl  = mods & MOD_MASK_CTRL;
+    const bool other = mods & (MOD_MASK_GUI | MOD_BIT(KC_LALT));
+
+    if (decoder->unicode_state == UNICODE_HEX) {
+        int digit = hex_digit(keycode);
+        if (digit >= 0 && !ctrl && !other) {
+            decoder->unicode_value = decoder->unicode_value * 16 + digit;
+            return;
+        }
+        if (keycode == KC_SPC || keycode == KC_ENT) {
+            put_utf8(decoder->unicode_value, out);
+        } else {
+            fprintf(out, "<bad unicode %X>", decoder->unicode_value);
+        }
+        decoder->unicode_state = UNICODE_IDLE;
+        return;
+    }
+
+    if (ctrl && shift && keycode == KC_U && !other) {
+        decoder->unicode_state = UNICODE_HEX;
+        decoder->unicode_value = 0;
+        return;
+    }
+    if (ctrl || other) {
+        fprintf(out, "<%s%s%s%s0x%02X>", mods & MOD_MASK_CTRL ? "C-" : "", mods & MOD_MASK_GUI ? "G-" : "", mods & MOD_BIT(KC_LALT) ? "A-" : "", shift ? "S-" : "", keycode);
+        return;
+    }
+    const char *name = key_name(keycode);
+    if (name != NULL) {
+        fputs(name, out);
+        return;
+    }
+    const glyph_t *glyph = find_glyph(keycode);
+    if (glyph == NULL) {
+        fprintf(out, "<0x%02X>", keycode);
+    } else if (altgr) {
+        fputs(shift ? glyph->altgr_shifted : glyph->altgr, out);
+    } else {
+        fputs(shift ? glyph->shifted : glyph->plain, out);
+    }
+}
+
+void sim_text_decode(sim_text_decoder_t *decoder, const sim_report_t *report, FILE *out) {
+    if (report->type != SIM_REPORT_KEYBOARD) {
+        return;
+    }
+    const report_keyboard_t *now = &report->keyboard;
+    for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t keycode = now->keys[i];
+        if (keycode == KC_NO || memchr(decoder->last.keys, keycode, KEYBOARD_REPORT_KEYS) != NULL) {
+            continue;
+        }
+        decode_press(decoder, keycode, now->mods, out);
+    }
+    decoder->last = *now;
+}
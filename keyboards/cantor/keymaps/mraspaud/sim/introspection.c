@@ -0,0 +1,56 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Builds keymap.c unchanged for the host, and provides what QMK's build
+// system generates around it: table sizes and community module hooks, and
+// the layer names for the host tools.
+
+#include <strings.h>
+
+#include "../keymap.c"
+#include "sim.h"
+
+uint8_t keymap_layer_count(void) {
+    return ARRAY_SIZE(keymaps);
+}
+
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (layer_num < keymap_layer_count() && row < MATRIX_ROWS && column < MATRIX_COLS) {
+        sim_stats.keymap_reads++;
+        return pgm_read_word(&keymaps[layer_num][row][column]);
+    }
+    return KC_TRNS;
+}
+
+int sim_layer_named(const char *name) {
+    static const struct {
+        const char *name;
+        uint8_t     layer;
+    } layers[] = {
+        {"base", L_BASE}, {"en", L_EN}, {"th", L_TH}, {"se", L_SE}, {"fr", L_FR}, {"numsym", L_NUMSYM}, {"nav", L_NAV}, {"frsym", L_FRSYM}, {"fn", L_FN},
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(layers); i++) {
+        if (strcasecmp(layers[i].name, name) == 0) {
+            return layers[i].layer;
+        }
+    }
+    return -1;
+}
+
+#ifdef COMBO_ENABLE
+uint16_t combo_count(void) {
+    return ARRAY_SIZE(key_combos);
+}
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+uint16_t tap_dance_count(void) {
+    return ARRAY_SIZE(tap_dance_actions);
+}
+#endif
+
+bool process_record_modules(uint16_t keycode, keyrecord_t *record) {
+    (void)keycode;
+    (void)record;
+    return true;
+}
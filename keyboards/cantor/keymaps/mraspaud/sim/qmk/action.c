@@ -0,0 +1,693 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Event pipeline: action_exec, the tap-hold state machine and
+// process_record, modelled on QMK's action.c, action_tapping.c,
+// action_layer.c and quantum.c.
+//
+// The tap-hold model covers what this keymap enables: TAPPING_TERM,
+// PERMISSIVE_HOLD, CHORDAL_HOLD, FLOW_TAP_TERM and SPECULATIVE_HOLD. A
+// tap-hold key stays undecided until it is released (tap), the tapping term
+// runs out (hold), another key is pressed and released inside it (permissive
+// hold), or a same-hand key is pressed (chordal hold settles it as a tap).
+// Events arriving while it is undecided wait in a buffer and are replayed in
+// order once it is settled.
+
+#include "sim.h"
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 1;
+
+static uint8_t       source_layers_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t locked_layers      = 0;
+static uint8_t       oneshot_layer_data = 0;
+static uint8_t       osm_held_mods      = 0;
+static bool          osm_interrupted    = false;
+static uint16_t      last_keycode       = KC_NO;
+static uint8_t       last_mods          = 0;
+
+/* Keymap lookup */
+
+__attribute__((weak)) uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return keycode_at_keymap_location(layer, key.row, key.col);
+    }
+    return KC_NO;
+}
+
+uint8_t layer_switch_get_layer(keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i)) {
+            if (keymap_key_to_keycode(i, key) != KC_TRNS) {
+                return i;
+            }
+        }
+    }
+    return 0;
+}
+
+void update_source_layers_cache(keypos_t key, uint8_t layer) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        source_layers_cache[key.row][key.col] = layer;
+    }
+}
+
+uint8_t read_source_layers_cache(keypos_t key) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return source_layers_cache[key.row][key.col];
+    }
+    return 0;
+}
+
+uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
+    uint8_t layer;
+    if (event.pressed && update_layer_cache) {
+        layer = layer_switch_get_layer(event.key);
+        update_source_layers_cache(event.key, layer);
+    } else {
+        layer = read_source_layers_cache(event.key);
+    }
+    return keymap_key_to_keycode(layer, event.key);
+}
+
+uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache) {
+    if (record->keycode) {
+        return record->keycode;
+    }
+    return get_event_keycode(record->event, update_layer_cache);
+}
+
+/* Layers */
+
+void layer_state_set(layer_state_t state) {
+    state         = layer_state_set_user(state);
+    layer_state   = state;
+    locked_layers &= state;
+}
+
+bool layer_state_cmp(layer_state_t cmp_layer_state, uint8_t layer) {
+    if (!cmp_layer_state) {
+        return layer == 0;
+    }
+    return (cmp_layer_state & ((layer_state_t)1 << layer)) != 0;
+}
+
+bool layer_state_is(uint8_t layer) {
+    return layer_state_cmp(layer_state, layer);
+}
+
+void layer_clear(void) {
+    layer_state_set(0);
+}
+
+void layer_move(uint8_t layer) {
+    layer_state_set((layer_state_t)1 << layer);
+}
+
+void layer_on(uint8_t layer) {
+    layer_state_set(layer_state | ((layer_state_t)1 << layer));
+}
+
+void layer_off(uint8_t layer) {
+    layer_state_set(layer_state & ~((layer_state_t)1 << layer));
+}
+
+void layer_invert(uint8_t layer) {
+    layer_state_set(layer_state ^ ((layer_state_t)1 << layer));
+}
+
+void default_layer_set(layer_state_t state) {
+    default_layer_state = default_layer_state_set_user(state);
+}
+
+uint8_t get_highest_layer(layer_state_t state) {
+    return state ? 31 - __builtin_clz(state) : 0;
+}
+
+bool is_layer_locked(uint8_t layer) {
+    return (locked_layers & ((layer_state_t)1 << layer)) != 0;
+}
+
+void layer_lock_on(uint8_t layer) {
+    locked_layers |= (layer_state_t)1 << layer;
+    layer_on(layer);
+}
+
+void layer_lock_off(uint8_t layer) {
+    locked_layers &= ~((layer_state_t)1 << layer);
+    layer_off(layer);
+}
+
+void layer_lock_invert(uint8_t layer) {
+    if (is_layer_locked(layer)) {
+        layer_lock_off(layer);
+    } else {
+        layer_lock_on(layer);
+    }
+}
+
+void layer_lock_all_off(void) {
+    for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+        if (is_layer_locked(layer)) {
+            layer_lock_off(layer);
+        }
+    }
+}
+
+static bool process_layer_lock(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == QK_LAYER_LOCK) {
+        if (record->event.pressed) {
+            layer_lock_invert(get_highest_layer(layer_state));
+        }
+        return false;
+    }
+    return true;
+}
+
+/* One-shot layer */
+
+uint8_t get_oneshot_layer(void) {
+    return oneshot_layer_data >> 3;
+}
+
+static uint8_t get_oneshot_layer_state(void) {
+    return oneshot_layer_data & 0b111;
+}
+
+bool is_oneshot_layer_active(void) {
+    return get_oneshot_layer_state() != 0;
+}
+
+void set_oneshot_layer(uint8_t layer, uint8_t state) {
+    oneshot_layer_data = (layer << 3) | state;
+    layer_on(layer);
+}
+
+void clear_oneshot_layer_state(uint8_t state) {
+    uint8_t start_state = oneshot_layer_data;
+    oneshot_layer_data &= ~state;
+    if (!get_oneshot_layer_state() && start_state != oneshot_layer_data) {
+        layer_off(get_oneshot_layer());
+        oneshot_layer_data = 0;
+    }
+}
+
+/* Repeat Key bookkeeping */
+
+uint16_t get_last_keycode(void) {
+    return last_keycode;
+}
+
+uint8_t get_last_mods(void) {
+    return last_mods;
+}
+
+/* Bootloader and reboot */
+
+void reset_keyboard(void) {
+    sim_report_t out = {.type = SIM_REPORT_BOOTLOADER};
+    sim_report_emit(&out);
+}
+
+void soft_reset_keyboard(void) {
+    sim_report_t out = {.type = SIM_REPORT_REBOOT};
+    sim_report_emit(&out);
+}
+
+/* Actions */
+
+static bool is_oneshot_key(uint16_t keycode) {
+    return IS_QK_ONE_SHOT_LAYER(keycode) || IS_QK_ONE_SHOT_MOD(keycode);
+}
+
+static void process_action(keyrecord_t *record, uint16_t keycode) {
+    const bool pressed            = record->event.pressed;
+    const bool tapped             = record->tap.count > 0;
+    bool       do_release_oneshot = false;
+
+    if (pressed && !is_oneshot_key(keycode)) {
+        osm_interrupted = true;
+    }
+    if (is_oneshot_layer_active() && pressed && !is_oneshot_key(keycode) && !IS_MODIFIER_KEYCODE(keycode) && !((IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) && !tapped)) {
+        clear_oneshot_layer_state(ONESHOT_OTHER_KEY_PRESSED);
+        do_release_oneshot = !is_oneshot_layer_active();
+    }
+
+    if (IS_QK_BASIC(keycode)) {
+        if (keycode > KC_TRNS) {
+            if (pressed) {
+                register_code(keycode);
+            } else {
+                unregister_code(keycode);
+            }
+        }
+    } else if (IS_QK_MODS(keycode)) {
+        const uint8_t mods = MOD5_TO_MOD8(QK_MODS_GET_MODS(keycode));
+        const uint8_t code = QK_MODS_GET_BASIC_KEYCODE(keycode);
+        const bool    real = IS_MODIFIER_KEYCODE(code) || code == KC_NO;
+        if (pressed) {
+            if (real) {
+                add_mods(mods);
+            } else {
+                add_weak_mods(mods);
+            }
+            send_keyboard_report();
+            register_code(code);
+        } else {
+            unregister_code(code);
+            if (real) {
+                del_mods(mods);
+            } else {
+                del_weak_mods(mods);
+            }
+            send_keyboard_report();
+        }
+    } else if (IS_QK_MOD_TAP(keycode)) {
+        const uint8_t mods = MOD5_TO_MOD8(QK_MOD_TAP_GET_MODS(keycode));
+        if (tapped) {
+            if (pressed) {
+                register_code(QK_MOD_TAP_GET_TAP_KEYCODE(keycode));
+            } else {
+                unregister_code(QK_MOD_TAP_GET_TAP_KEYCODE(keycode));
+            }
+        } else if (pressed) {
+            register_mods(mods);
+        } else {
+            unregister_mods(mods);
+        }
+    } else if (IS_QK_LAYER_TAP(keycode)) {
+        const uint8_t layer = QK_LAYER_TAP_GET_LAYER(keycode);
+        if (tapped) {
+            if (pressed) {
+                register_code(QK_LAYER_TAP_GET_TAP_KEYCODE(keycode));
+            } else {
+                unregister_code(QK_LAYER_TAP_GET_TAP_KEYCODE(keycode));
+            }
+        } else if (pressed) {
+            layer_on(layer);
+        } else if (!is_layer_locked(layer)) {
+            layer_off(layer);
+        }
+    } else if (IS_QK_TO(keycode)) {
+        if (pressed) {
+            layer_move(QK_TO_GET_LAYER(keycode));
+        }
+    } else if (IS_QK_MOMENTARY(keycode)) {
+        const uint8_t layer = QK_MOMENTARY_GET_LAYER(keycode);
+        if (pressed) {
+            layer_on(layer);
+        } else if (!is_layer_locked(layer)) {
+            layer_off(layer);
+        }
+    } else if (keycode >= QK_TOGGLE_LAYER && keycode <= QK_TOGGLE_LAYER_MAX) {
+        if (pressed) {
+            layer_invert(keycode & 0x1F);
+        }
+    } else if (IS_QK_ONE_SHOT_LAYER(keycode)) {
+        if (pressed) {
+            set_oneshot_layer(QK_ONE_SHOT_LAYER_GET_LAYER(keycode), ONESHOT_START);
+        } else {
+            clear_oneshot_layer_state(ONESHOT_PRESSED);
+        }
+    } else if (IS_QK_ONE_SHOT_MOD(keycode)) {
+        const uint8_t mods = MOD5_TO_MOD8(QK_ONE_SHOT_MOD_GET_MODS(keycode));
+        if (pressed) {
+            osm_held_mods   = mods;
+            osm_interrupted = false;
+            register_mods(mods);
+        } else {
+            unregister_mods(mods);
+            if (!osm_interrupted && osm_held_mods == mods) {
+                add_oneshot_mods(mods);
+            }
+            osm_held_mods = 0;
+        }
+    }
+
+    if (do_release_oneshot) {
+        record->event.pressed = false;
+        process_record(record);
+        record->event.pressed = true;
+    }
+}
+
+static bool process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+#ifdef TAP_DANCE_ENABLE
+    if (preprocess_tap_dance(keycode, record)) {
+        keycode = get_record_keycode(record, true);
+    }
+#endif
+#ifdef REPEAT_KEY_ENABLE
+    if (record->event.pressed && keycode != QK_REPEAT_KEY && keycode != QK_ALT_REPEAT_KEY) {
+        last_keycode = keycode;
+        last_mods    = get_mods() | get_weak_mods() | get_oneshot_mods();
+    }
+#endif
+
+    bool user_result;
+    if (sim_stats_enabled) {
+        const uint64_t start = sim_wall_ns();
+        user_result          = true;
+        if (
+#ifdef CAPS_WORD_ENABLE
+            process_caps_word(keycode, record) &&
+#endif
+#ifdef LAYER_LOCK_ENABLE
+            process_layer_lock(keycode, record) &&
+#endif
+            process_record_modules(keycode, record)) {
+            user_result = process_record_user(keycode, record);
+        } else {
+            return false;
+        }
+        sim_stats.user_ns += sim_wall_ns() - start;
+        sim_stats.user_calls++;
+    } else {
+        user_result =
+#ifdef CAPS_WORD_ENABLE
+            process_caps_word(keycode, record) &&
+#endif
+#ifdef LAYER_LOCK_ENABLE
+            process_layer_lock(keycode, record) &&
+#endif
+            process_record_modules(keycode, record) && process_record_user(keycode, record);
+    }
+
+    if (!(user_result &&
+#ifdef TAP_DANCE_ENABLE
+          process_tap_dance(keycode, record) &&
+#endif
+#ifdef UNICODE_COMMON_ENABLE
+          process_unicode_common(keycode, record) &&
+#endif
+          true)) {
+        return false;
+    }
+
+    if (record->event.pressed) {
+        switch (keycode) {
+            case QK_BOOTLOADER:
+                reset_keyboard();
+                return false;
+            case QK_REBOOT:
+                soft_reset_keyboard();
+                return false;
+        }
+    }
+    return true;
+}
+
+void process_record(keyrecord_t *record) {
+    if (IS_NOEVENT(record->event)) {
+        return;
+    }
+    if (!process_record_quantum(record)) {
+        if (is_oneshot_layer_active() && record->event.pressed) {
+            clear_oneshot_layer_state(ONESHOT_OTHER_KEY_PRESSED);
+        }
+        return;
+    }
+    const uint16_t keycode = get_record_keycode(record, false);
+    process_action(record, keycode);
+    post_process_record_user(keycode, record);
+}
+
+/* Tap-hold state machine */
+
+enum { TH_NONE, TH_TAP, TH_HOLD };
+
+#define WAITING_BUFFER_SIZE 8
+
+static uint8_t     tap_hold_state[MATRIX_ROWS][MATRIX_COLS];
+static bool        tapping_pending = false;
+static keyrecord_t tapping_key;
+static uint16_t    tapping_keycode;
+static uint32_t    tapping_start;
+static uint8_t     speculative_mods = 0;
+static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE];
+static uint8_t     waiting_count = 0;
+static bool        flushing      = false;  // Replaying presses that waited.
+static uint16_t    flow_prev_keycode;
+static uint16_t    flow_prev_time;
+static bool        flow_prev_valid = false;
+
+static bool is_tap_hold(uint16_t keycode) {
+    return IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode);
+}
+
+static bool same_key(const keyrecord_t *a, const keyrecord_t *b) {
+    return a->event.type == KEY_EVENT && b->event.type == KEY_EVENT && a->event.key.row == b->event.key.row && a->event.key.col == b->event.key.col;
+}
+
+static const sim_tap_hold_terms_t *tuned_terms       = NULL;
+static uint8_t                     tuned_count       = 0;
+static sim_tap_hold_observer_t     tap_hold_observer = NULL;
+static void                       *observer_arg      = NULL;
+
+void sim_set_tap_hold_terms(const sim_tap_hold_terms_t *terms, uint8_t count) {
+    tuned_terms = terms;
+    tuned_count = count;
+}
+
+void sim_set_tap_hold_observer(sim_tap_hold_observer_t observer, void *arg) {
+    tap_hold_observer = observer;
+    observer_arg      = arg;
+}
+
+static const sim_tap_hold_terms_t *tuned(uint16_t keycode) {
+    for (uint8_t i = 0; i < tuned_count; i++) {
+        if (tuned_terms[i].keycode == keycode) {
+            return &tuned_terms[i];
+        }
+    }
+    return NULL;
+}
+
+static void observe_settled(const keyrecord_t *record, uint16_t keycode, bool tap) {
+    if (tap_hold_observer != NULL) {
+        tap_hold_observer(record, keycode, tap, observer_arg);
+    }
+}
+
+#ifdef FLOW_TAP_TERM
+static uint16_t flow_tap_term(uint16_t keycode, keyrecord_t *record, uint16_t prev_keycode) {
+    const sim_tap_hold_terms_t *terms = tuned(keycode);
+    if (terms != NULL) {
+        return is_flow_tap_key(keycode) && is_flow_tap_key(prev_keycode) ? terms->flow_tap_term : 0;
+    }
+    return get_flow_tap_term(keycode, record, prev_keycode);
+}
+#endif
+
+static uint16_t tapping_term(uint16_t keycode, keyrecord_t *record) {
+    const sim_tap_hold_terms_t *terms = tuned(keycode);
+    if (terms != NULL) {
+        return terms->tapping_term;
+    }
+#ifdef TAPPING_TERM_PER_KEY
+    return get_tapping_term(keycode, record);
+#else
+    return TAPPING_TERM;
+#endif
+}
+
+// Reconstructs the 32-bit time of a recent 16-bit event timestamp. Event
+// times have their low bit forced on, so they may run up to 1 ms ahead.
+static uint32_t event_time32(uint16_t time) {
+    int16_t age = (int16_t)TIMER_DIFF_16(timer_read(), time);
+    return age > 0 ? timer_read32() - age : timer_read32();
+}
+
+static void process_settled(keyrecord_t *record) {
+    if (record->event.type == KEY_EVENT && !record->event.pressed) {
+        uint8_t *state = &tap_hold_state[record->event.key.row][record->event.key.col];
+        if (*state != TH_NONE) {
+            record->tap.count = *state == TH_TAP ? 1 : 0;
+            *state            = TH_NONE;
+        }
+    }
+    process_record(record);
+}
+
+static void update_flow_tap(uint16_t keycode, const keyrecord_t *record) {
+    flow_prev_keycode = keycode;
+    flow_prev_time    = record->event.time;
+    flow_prev_valid   = true;
+}
+
+static void flush_waiting_buffer(void) {
+    keyrecord_t pending[WAITING_BUFFER_SIZE];
+    uint8_t     count = waiting_count;
+    memcpy(pending, waiting_buffer, sizeof(keyrecord_t) * count);
+    waiting_count = 0;
+    const bool was_flushing = flushing;
+    flushing                = true;
+    for (uint8_t i = 0; i < count; i++) {
+        action_tapping_process(pending[i]);
+    }
+    flushing = was_flushing;
+}
+
+static void settle_tapping_key(bool tap) {
+    tapping_pending = false;
+    if (tap && speculative_mods) {
+        unregister_mods(speculative_mods);
+    }
+    speculative_mods                                                           = 0;
+    tap_hold_state[tapping_key.event.key.row][tapping_key.event.key.col] = tap ? TH_TAP : TH_HOLD;
+    keyrecord_t record                                                         = tapping_key;
+    record.tap.count                                                           = tap ? 1 : 0;
+    observe_settled(&record, tapping_keycode, tap);
+    process_record(&record);
+}
+
+// Compares positions only, as QMK's waiting_buffer_typed() does, so that the
+// release of a combo matches its buffered press.
+static bool in_waiting_buffer(const keyrecord_t *record) {
+    for (uint8_t i = 0; i < waiting_count; i++) {
+        if (KEYEQ(waiting_buffer[i].event.key, record->event.key) && waiting_buffer[i].event.pressed) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void action_tapping_process(keyrecord_t record) {
+    if (tapping_pending) {
+        if (same_key(&record, &tapping_key)) {
+            if (!record.event.pressed) {
+                // Released within the tapping term: a tap.
+                settle_tapping_key(true);
+                flush_waiting_buffer();
+                process_settled(&record);
+            }
+            return;
+        }
+        if (record.event.pressed) {
+#ifdef CHORDAL_HOLD
+            if (record.event.type == KEY_EVENT && !get_chordal_hold(tapping_keycode, &tapping_key, get_record_keycode(&record, false), &record)) {
+                settle_tapping_key(true);
+                flush_waiting_buffer();
+                action_tapping_process(record);
+                return;
+            }
+#endif
+            if (waiting_count < WAITING_BUFFER_SIZE) {
+                waiting_buffer[waiting_count++] = record;
+            } else {
+                settle_tapping_key(false);
+                flush_waiting_buffer();
+                action_tapping_process(record);
+            }
+            return;
+        }
+        if (in_waiting_buffer(&record)) {
+#ifdef PERMISSIVE_HOLD
+            // Another key pressed and released inside the term: a hold. The
+            // release goes through tapping again, as the flushed press may
+            // have been a tap-hold key itself.
+            settle_tapping_key(false);
+            flush_waiting_buffer();
+            action_tapping_process(record);
+#else
+            waiting_buffer[waiting_count++] = record;
+#endif
+            return;
+        }
+        // Release of a key pressed before the tap-hold key.
+        process_settled(&record);
+        return;
+    }
+
+    if (record.event.type == KEY_EVENT && record.event.pressed) {
+        // Looked up on the layers on now, as QMK's is_tap_record() does: a
+        // press that waited behind a layer-tap comes out on its layer.
+        const uint16_t keycode = get_record_keycode(&record, true);
+        if (is_tap_hold(keycode)) {
+#ifdef FLOW_TAP_TERM
+            if (flow_prev_valid) {
+                const uint16_t term = flow_tap_term(keycode, &record, flow_prev_keycode);
+                if (term > 0 && TIMER_DIFF_16(record.event.time, flow_prev_time) < term) {
+                    update_flow_tap(keycode, &record);
+                    tap_hold_state[record.event.key.row][record.event.key.col] = TH_TAP;
+                    record.tap.count                                           = 1;
+                    observe_settled(&record, keycode, true);
+                    process_record(&record);
+                    return;
+                }
+            }
+#endif
+            tapping_pending = true;
+            tapping_key     = record;
+            tapping_keycode = keycode;
+            tapping_start   = event_time32(record.event.time);
+#ifdef SPECULATIVE_HOLD
+            // Only for a press that did not wait behind another tap-hold key.
+            if (!flushing && IS_QK_MOD_TAP(keycode) && get_speculative_hold(keycode, &record)) {
+                speculative_mods = MOD5_TO_MOD8(QK_MOD_TAP_GET_MODS(keycode)) & ~get_mods();
+                register_mods(speculative_mods);
+            }
+#endif
+            update_flow_tap(keycode, &record);
+            return;
+        }
+        update_flow_tap(keycode, &record);
+    }
+    process_settled(&record);
+}
+
+uint64_t sim_action_deadline_us(void) {
+    if (!tapping_pending) {
+        return SIM_NO_DEADLINE;
+    }
+    return ((uint64_t)tapping_start + tapping_term(tapping_keycode, &tapping_key)) * 1000;
+}
+
+void sim_action_task(void) {
+    if (tapping_pending && timer_elapsed32(tapping_start) >= tapping_term(tapping_keycode, &tapping_key)) {
+        settle_tapping_key(false);
+        flush_waiting_buffer();
+    }
+}
+
+/* Entry point */
+
+bool pre_process_record_quantum(keyrecord_t *record) {
+    const uint16_t keycode = get_record_keycode(record, true);
+    return pre_process_record_user(keycode, record) &&
+#ifdef COMBO_ENABLE
+           process_combo(keycode, record) &&
+#endif
+           true;
+}
+
+void action_exec(keyevent_t event) {
+    if (event.pressed) {
+        // Clear the potential weak mods left by previously pressed keys.
+        clear_weak_mods();
+    }
+    keyrecord_t record = {.event = event};
+    if (IS_NOEVENT(record.event) || pre_process_record_quantum(&record)) {
+        action_tapping_process(record);
+    }
+}
+
+void sim_action_reset(void) {
+    layer_state         = 0;
+    default_layer_state = 1;
+    memset(source_layers_cache, 0, sizeof(source_layers_cache));
+    memset(tap_hold_state, 0, sizeof(tap_hold_state));
+    locked_layers      = 0;
+    oneshot_layer_data = 0;
+    osm_held_mods      = 0;
+    last_keycode       = KC_NO;
+    last_mods          = 0;
+    tapping_pending    = false;
+    speculative_mods   = 0;
+    flushing           = false;
+    waiting_count      = 0;
+    flow_prev_valid    = false;
+}
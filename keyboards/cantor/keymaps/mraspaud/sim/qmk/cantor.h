@@ -0,0 +1,28 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Keyboard header standing in for QMK_KEYBOARD_H. The left half uses matrix
+// rows 0-3 and the right half rows 4-7; the thumb keys sit on the last row of
+// each half, next to the inner columns.
+
+#pragma once
+
+#include "quantum.h"
+
+// clang-format off
+#define LAYOUT_split_3x6_3( \
+    k00, k01, k02, k03, k04, k05,           k40, k41, k42, k43, k44, k45, \
+    k10, k11, k12, k13, k14, k15,           k50, k51, k52, k53, k54, k55, \
+    k20, k21, k22, k23, k24, k25,           k60, k61, k62, k63, k64, k65, \
+                        k33, k34, k35, k70, k71, k72 \
+) { \
+    { k00, k01, k02, k03, k04, k05 }, \
+    { k10, k11, k12, k13, k14, k15 }, \
+    { k20, k21, k22, k23, k24, k25 }, \
+    { KC_NO, KC_NO, KC_NO, k33, k34, k35 }, \
+    { k40, k41, k42, k43, k44, k45 }, \
+    { k50, k51, k52, k53, k54, k55 }, \
+    { k60, k61, k62, k63, k64, k65 }, \
+    { k70, k71, k72, KC_NO, KC_NO, KC_NO } \
+}
+// clang-format on
@@ -0,0 +1,135 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Caps Word, following QMK's caps_word.c and process_caps_word.c.
+
+#include "sim.h"
+
+#ifdef CAPS_WORD_ENABLE
+
+static bool     caps_word_active = false;
+static uint32_t idle_timer;
+
+bool is_caps_word_on(void) {
+    return caps_word_active;
+}
+
+void caps_word_on(void) {
+    if (caps_word_active) {
+        return;
+    }
+    clear_mods();
+    clear_oneshot_mods();
+    idle_timer       = timer_read32();
+    caps_word_active = true;
+    caps_word_set_user(true);
+}
+
+void caps_word_off(void) {
+    if (!caps_word_active) {
+        return;
+    }
+    unregister_weak_mods(MOD_MASK_SHIFT);
+    caps_word_active = false;
+    caps_word_set_user(false);
+}
+
+void caps_word_toggle(void) {
+    if (caps_word_active) {
+        caps_word_off();
+    } else {
+        caps_word_on();
+    }
+}
+
+bool process_caps_word(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == QK_CAPS_WORD_TOGGLE) {
+        if (record->event.pressed) {
+            caps_word_toggle();
+        }
+        return false;
+    }
+    if (!caps_word_active || !record->event.pressed) {
+        return true;
+    }
+
+    if (!((get_mods() | get_oneshot_mods()) & ~(MOD_MASK_SHIFT | MOD_BIT(KC_RALT)))) {
+        switch (keycode) {
+            // Ignore modifier and layer keys.
+            case QK_MODS ... QK_MODS_MAX:
+            case QK_MOMENTARY ... QK_MOMENTARY_MAX:
+            case QK_TO ... QK_TO_MAX:
+            case QK_TOGGLE_LAYER ... QK_TOGGLE_LAYER_MAX:
+            case QK_ONE_SHOT_LAYER ... QK_ONE_SHOT_LAYER_MAX:
+            case QK_ONE_SHOT_MOD ... QK_ONE_SHOT_MOD_MAX:
+            case QK_LAYER_LOCK:
+                if (IS_QK_MODS(keycode) && !IS_MODIFIER_KEYCODE(QK_MODS_GET_BASIC_KEYCODE(keycode))) {
+                    break;
+                }
+                return true;
+            case KC_LEFT_CTRL ... KC_RIGHT_GUI:
+                return true;
+            case QK_MOD_TAP ... QK_MOD_TAP_MAX:
+                // Mod-tap hold: ignore. Mod-tap tap: treat as the tapped key.
+                if (record->tap.count == 0) {
+                    return true;
+                }
+                keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+                break;
+            case QK_LAYER_TAP ... QK_LAYER_TAP_MAX:
+                if (record->tap.count == 0) {
+                    return true;
+                }
+                keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+                break;
+#    ifdef TAP_DANCE_ENABLE
+            case QK_TAP_DANCE ... QK_TAP_DANCE_MAX:
+                // Tap dances keep Caps Word alive but are not shifted.
+                return true;
+#    endif
+        }
+
+        clear_weak_mods();
+        if (caps_word_press_user(keycode)) {
+            send_keyboard_report();
+            idle_timer = timer_read32();
+            return true;
+        }
+    }
+
+    caps_word_off();
+    return true;
+}
+
+void caps_word_task(void) {
+    if (caps_word_active && timer_elapsed32(idle_timer) >= CAPS_WORD_IDLE_TIMEOUT) {
+        caps_word_off();
+    }
+}
+
+uint64_t sim_caps_word_deadline_us(void) {
+    if (!caps_word_active) {
+        return SIM_NO_DEADLINE;
+    }
+    return ((uint64_t)idle_timer + CAPS_WORD_IDLE_TIMEOUT) * 1000;
+}
+
+void sim_caps_word_reset(void) {
+    caps_word_active = false;
+}
+
+#else
+
+bool is_caps_word_on(void) {
+    return false;
+}
+
+void caps_word_task(void) {}
+
+uint64_t sim_caps_word_deadline_us(void) {
+    return SIM_NO_DEADLINE;
+}
+
+void sim_caps_word_reset(void) {}
+
+#endif
@@ -0,0 +1,16 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// The part of ChibiOS the keymap uses directly: the realtime counter, here
+// ticking once per microsecond of virtual time, and sleeping, which takes
+// none: the simulator runs the keyboard task on events, not on scans.
+
+#pragma once
+
+#include <stdint.h>
+
+uint64_t sim_time_us(void);
+
+#define STM32_SYSCLK 1000000U
+#define chSysGetRealtimeCounterX() ((uint32_t)sim_time_us())
+#define chThdSleepMicroseconds(us) ((void)(us))
@@ -0,0 +1,232 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Keycode-based combos, following QMK's process_combo.c: presses of keys
+// that belong to some combo are held back until either a combo completes or
+// the buffered keys can no longer form one (a non-member key, a release, or
+// COMBO_TERM running out), in which case they are replayed unchanged.
+
+#include "sim.h"
+
+#ifdef COMBO_ENABLE
+
+#    define COMBO_BUFFER_LENGTH 8
+#    define COMBO_MAX_COMBOS 32
+#    define COMBO_MAX_KEYS 4
+
+typedef struct {
+    keypos_t keys[COMBO_MAX_KEYS];
+    uint8_t  key_count;
+    bool     released;
+} active_combo_t;
+
+static keyrecord_t    buffer[COMBO_BUFFER_LENGTH];
+static uint16_t       buffer_keycodes[COMBO_BUFFER_LENGTH];
+static uint8_t        buffer_count = 0;
+static uint32_t       buffer_start;
+static uint32_t       candidates = 0;
+static active_combo_t active[COMBO_MAX_COMBOS];
+
+static uint8_t combo_key_count(uint16_t index) {
+    uint8_t count = 0;
+    while (pgm_read_word(&key_combos[index].keys[count]) != COMBO_END) {
+        count++;
+    }
+    return count;
+}
+
+static uint32_t combos_with_keycode(uint16_t keycode) {
+    uint32_t mask = 0;
+    for (uint16_t i = 0; i < combo_count() && i < COMBO_MAX_COMBOS; i++) {
+        for (uint8_t k = 0; k < combo_key_count(i); k++) {
+            if (pgm_read_word(&key_combos[i].keys[k]) == keycode) {
+                mask |= (uint32_t)1 << i;
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+static int8_t buffered_record_for(uint16_t keycode, uint8_t used) {
+    for (uint8_t b = 0; b < buffer_count; b++) {
+        if (!(used & (1 << b)) && buffer_keycodes[b] == keycode) {
+            return b;
+        }
+    }
+    return -1;
+}
+
+// Returns the buffer slots that complete combo `index`, or 0.
+static uint8_t combo_completion(uint16_t index) {
+    uint8_t used = 0;
+    for (uint8_t k = 0; k < combo_key_count(index); k++) {
+        int8_t b = buffered_record_for(pgm_read_word(&key_combos[index].keys[k]), used);
+        if (b < 0) {
+            return 0;
+        }
+        used |= 1 << b;
+    }
+    return used;
+}
+
+// The complete candidate with the most keys, preferring earlier combos.
+static int16_t completed_candidate(bool check_trigger) {
+    int16_t best      = -1;
+    uint8_t best_size = 0;
+    for (uint16_t i = 0; i < combo_count() && i < COMBO_MAX_COMBOS; i++) {
+        if (!(candidates & ((uint32_t)1 << i)) || !combo_completion(i)) {
+            continue;
+        }
+        if (check_trigger && !combo_should_trigger(i, &key_combos[i], key_combos[i].keycode, &buffer[0])) {
+            continue;
+        }
+        if (combo_key_count(i) > best_size) {
+            best      = i;
+            best_size = combo_key_count(i);
+        }
+    }
+    return best;
+}
+
+static bool incomplete_candidate_left(void) {
+    for (uint16_t i = 0; i < combo_count() && i < COMBO_MAX_COMBOS; i++) {
+        if ((candidates & ((uint32_t)1 << i)) && !combo_completion(i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void dump_buffer(void) {
+    keyrecord_t records[COMBO_BUFFER_LENGTH];
+    uint8_t     count = buffer_count;
+    memcpy(records, buffer, sizeof(keyrecord_t) * count);
+    buffer_count = 0;
+    candidates   = 0;
+    for (uint8_t b = 0; b < count; b++) {
+        action_tapping_process(records[b]);
+    }
+}
+
+static void fire_combo(uint16_t index) {
+    uint8_t         used  = combo_completion(index);
+    active_combo_t *combo = &active[index];
+    combo->key_count      = 0;
+    combo->released       = false;
+
+    uint8_t kept = 0;
+    for (uint8_t b = 0; b < buffer_count; b++) {
+        if (used & (1 << b)) {
+            combo->keys[combo->key_count++] = buffer[b].event.key;
+        } else {
+            buffer[kept]          = buffer[b];
+            buffer_keycodes[kept] = buffer_keycodes[b];
+            kept++;
+        }
+    }
+    buffer_count = kept;
+
+    keyrecord_t record = {.event = MAKE_COMBOEVENT(true), .keycode = key_combos[index].keycode};
+    action_tapping_process(record);
+    dump_buffer();
+}
+
+static void resolve_buffer(void) {
+    int16_t done = completed_candidate(true);
+    if (done >= 0) {
+        fire_combo(done);
+    } else {
+        dump_buffer();
+    }
+}
+
+static bool release_active_combo_key(keyrecord_t *record) {
+    for (uint16_t i = 0; i < COMBO_MAX_COMBOS; i++) {
+        active_combo_t *combo = &active[i];
+        for (uint8_t k = 0; k < combo->key_count; k++) {
+            if (combo->keys[k].row != record->event.key.row || combo->keys[k].col != record->event.key.col) {
+                continue;
+            }
+            if (!combo->released) {
+                combo->released    = true;
+                keyrecord_t combo_record = {.event = MAKE_COMBOEVENT(false), .keycode = key_combos[i].keycode};
+                action_tapping_process(combo_record);
+            }
+            combo->keys[k] = combo->keys[--combo->key_count];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool process_combo(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.type != KEY_EVENT) {
+        return true;
+    }
+
+    if (!record->event.pressed) {
+        if (release_active_combo_key(record)) {
+            return false;
+        }
+        for (uint8_t b = 0; b < buffer_count; b++) {
+            if (buffer[b].event.key.row == record->event.key.row && buffer[b].event.key.col == record->event.key.col) {
+                resolve_buffer();
+                return release_active_combo_key(record) ? false : true;
+            }
+        }
+        return true;
+    }
+
+    uint32_t with_key = combos_with_keycode(keycode);
+    if (buffer_count == 0) {
+        if (!with_key) {
+            return true;
+        }
+        candidates   = with_key;
+        buffer_start = timer_read32();
+    } else if (!(candidates & with_key) || buffer_count == COMBO_BUFFER_LENGTH) {
+        resolve_buffer();
+        return process_combo(keycode, record);
+    } else {
+        candidates &= with_key;
+    }
+
+    buffer_keycodes[buffer_count] = keycode;
+    buffer[buffer_count++]        = *record;
+    if (!incomplete_candidate_left()) {
+        resolve_buffer();
+    }
+    return false;
+}
+
+void combo_task(void) {
+    if (buffer_count > 0 && timer_elapsed32(buffer_start) >= COMBO_TERM) {
+        resolve_buffer();
+    }
+}
+
+uint64_t sim_combo_deadline_us(void) {
+    if (buffer_count == 0) {
+        return SIM_NO_DEADLINE;
+    }
+    return ((uint64_t)buffer_start + COMBO_TERM) * 1000;
+}
+
+void sim_combo_reset(void) {
+    buffer_count = 0;
+    candidates   = 0;
+    memset(active, 0, sizeof(active));
+}
+
+#else
+
+void combo_task(void) {}
+
+uint64_t sim_combo_deadline_us(void) {
+    return SIM_NO_DEADLINE;
+}
+
+void sim_combo_reset(void) {}
+
+#endif
@@ -0,0 +1,147 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Deferred execution, following QMK's deferred_exec.c.
+
+#include "sim.h"
+
+#ifdef DEFERRED_EXEC_ENABLE
+
+typedef struct {
+    deferred_token         token;
+    uint32_t               trigger_time;
+    deferred_exec_callback callback;
+    void                  *cb_arg;
+} deferred_executor_t;
+
+static deferred_executor_t executors[MAX_DEFERRED_EXECUTORS];
+static deferred_token      current_token = 0;
+static uint32_t            last_check    = 0;
+
+static deferred_executor_t *find_executor(deferred_token token) {
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return NULL;
+    }
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        if (executors[i].token == token) {
+            return &executors[i];
+        }
+    }
+    return NULL;
+}
+
+static deferred_token allocate_token(void) {
+    deferred_token first = ++current_token;
+    while (current_token == INVALID_DEFERRED_TOKEN || find_executor(current_token) != NULL) {
+        ++current_token;
+        if (current_token == first) {
+            return INVALID_DEFERRED_TOKEN;
+        }
+    }
+    return current_token;
+}
+
+deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
+    if (delay_ms == 0 || callback == NULL) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        deferred_executor_t *entry = &executors[i];
+        if (entry->token == INVALID_DEFERRED_TOKEN) {
+            entry->token = allocate_token();
+            if (entry->token == INVALID_DEFERRED_TOKEN) {
+                return INVALID_DEFERRED_TOKEN;
+            }
+            entry->trigger_time = timer_read32() + delay_ms;
+            entry->callback     = callback;
+            entry->cb_arg       = cb_arg;
+            return entry->token;
+        }
+    }
+    return INVALID_DEFERRED_TOKEN;
+}
+
+bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
+    deferred_executor_t *entry = find_executor(token);
+    if (delay_ms == 0 || entry == NULL) {
+        return false;
+    }
+    entry->trigger_time = timer_read32() + delay_ms;
+    return true;
+}
+
+bool cancel_deferred_exec(deferred_token token) {
+    deferred_executor_t *entry = find_executor(token);
+    if (entry == NULL) {
+        return false;
+    }
+    entry->token        = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
+    return true;
+}
+
+static bool timer_expired32(uint32_t current, uint32_t future) {
+    return (uint32_t)(current - future) < 0x80000000;
+}
+
+void deferred_exec_task(void) {
+    uint32_t now = timer_read32();
+    // Throttle only once per millisecond
+    if (now == last_check) {
+        return;
+    }
+    last_check = now;
+
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        deferred_executor_t *entry = &executors[i];
+        if (entry->token != INVALID_DEFERRED_TOKEN && timer_expired32(now, entry->trigger_time)) {
+            uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+            if (entry->token == INVALID_DEFERRED_TOKEN) {
+                // Cancelled from within its own callback.
+                continue;
+            }
+            if (delay_ms > 0) {
+                entry->trigger_time += delay_ms;
+            } else {
+                cancel_deferred_exec(entry->token);
+            }
+        }
+    }
+}
+
+uint64_t sim_deferred_exec_deadline_us(void) {
+    uint64_t deadline = SIM_NO_DEADLINE;
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        if (executors[i].token != INVALID_DEFERRED_TOKEN) {
+            uint64_t t = (uint64_t)executors[i].trigger_time * 1000;
+            // Tasks run at most once per millisecond.
+            if (t <= (uint64_t)last_check * 1000) {
+                t = ((uint64_t)last_check + 1) * 1000;
+            }
+            if (t < deadline) {
+                deadline = t;
+            }
+        }
+    }
+    return deadline;
+}
+
+void sim_deferred_exec_reset(void) {
+    memset(executors, 0, sizeof(executors));
+    current_token = 0;
+    last_check    = 0;
+}
+
+#else
+
+void deferred_exec_task(void) {}
+
+uint64_t sim_deferred_exec_deadline_us(void) {
+    return SIM_NO_DEADLINE;
+}
+
+void sim_deferred_exec_reset(void) {}
+
+#endif
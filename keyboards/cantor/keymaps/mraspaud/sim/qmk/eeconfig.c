@@ -0,0 +1,58 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// The user part of QMK's eeconfig: the user word and the user datablock,
+// kept in RAM. Every simulated boot starts from a blank EEPROM.
+
+#include "sim.h"
+
+static uint32_t user_word = 0;
+#if (EECONFIG_USER_DATA_SIZE) > 0
+static uint8_t user_data[EECONFIG_USER_DATA_SIZE];
+#endif
+
+__attribute__((weak)) void eeconfig_init_user(void) {}
+
+uint32_t eeconfig_read_user(void) {
+    return user_word;
+}
+
+void eeconfig_update_user(uint32_t value) {
+    user_word = value;
+}
+
+#if (EECONFIG_USER_DATA_SIZE) > 0
+uint32_t eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t size) {
+    if (offset >= EECONFIG_USER_DATA_SIZE) {
+        return 0;
+    }
+    if (size > EECONFIG_USER_DATA_SIZE - offset) {
+        size = EECONFIG_USER_DATA_SIZE - offset;
+    }
+    memcpy(data, &user_data[offset], size);
+    return size;
+}
+
+uint32_t eeconfig_update_user_datablock(const void *data, uint32_t offset, uint32_t size) {
+    if (offset >= EECONFIG_USER_DATA_SIZE) {
+        return 0;
+    }
+    if (size > EECONFIG_USER_DATA_SIZE - offset) {
+        size = EECONFIG_USER_DATA_SIZE - offset;
+    }
+    if (memcmp(&user_data[offset], data, size) != 0) {
+        memcpy(&user_data[offset], data, size);
+        sim_stats.eeprom_writes++;
+    }
+    return size;
+}
+#endif
+
+// A blank EEPROM fails QMK's magic check at boot, which runs the init hooks.
+void sim_eeconfig_reset(void) {
+    user_word = 0;
+#if (EECONFIG_USER_DATA_SIZE) > 0
+    memset(user_data, 0, sizeof(user_data));
+#endif
+    eeconfig_init_user();
+}
@@ -0,0 +1,236 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Keyboard task, boot and the default (weak) hooks, following QMK's
+// keyboard.c, quantum.c and action_tapping.c.
+
+#include "cantor.h"
+#include "sim.h"
+
+sim_stats_t sim_stats;
+bool        sim_stats_enabled = false;
+
+static uint32_t scan_period_us = 0;
+
+/* Default hooks */
+
+__attribute__((weak)) void keyboard_pre_init_user(void) {}
+__attribute__((weak)) void keyboard_post_init_user(void) {}
+__attribute__((weak)) void matrix_scan_user(void) {}
+__attribute__((weak)) void housekeeping_task_user(void) {}
+
+__attribute__((weak)) bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+
+__attribute__((weak)) bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+
+__attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_t *record) {}
+
+__attribute__((weak)) layer_state_t layer_state_set_user(layer_state_t state) {
+    return state;
+}
+
+__attribute__((weak)) layer_state_t default_layer_state_set_user(layer_state_t state) {
+    return state;
+}
+
+__attribute__((weak)) bool combo_should_trigger(uint16_t combo_index, combo_t *combo, uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+
+__attribute__((weak)) void caps_word_set_user(bool active) {}
+
+__attribute__((weak)) bool caps_word_press_user(uint16_t keycode) {
+    switch (keycode) {
+        // Keycodes that continue Caps Word, with shift applied.
+        case KC_A ... KC_Z:
+        case KC_MINS:
+            add_weak_mods(MOD_BIT(KC_LSFT));
+            return true;
+
+        // Keycodes that continue Caps Word, without shifting.
+        case KC_1 ... KC_0:
+        case KC_BSPC:
+        case KC_DEL:
+        case KC_UNDS:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+__attribute__((weak)) uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    return TAPPING_TERM;
+}
+
+__attribute__((weak)) bool is_flow_tap_key(uint16_t keycode) {
+    if ((get_mods() & (MOD_MASK_CG | MOD_BIT(KC_LALT))) != 0) {
+        return false;  // Disable Flow Tap on hotkeys.
+    }
+    switch (keycode) {
+        case QK_MOD_TAP ... QK_MOD_TAP_MAX:
+            keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+            break;
+        case QK_LAYER_TAP ... QK_LAYER_TAP_MAX:
+            keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+            break;
+    }
+    switch (keycode) {
+        case KC_SPC:
+        case KC_A ... KC_Z:
+        case KC_DOT:
+        case KC_COMM:
+        case KC_SCLN:
+        case KC_SLSH:
+            return true;
+    }
+    return false;
+}
+
+#ifdef FLOW_TAP_TERM
+__attribute__((weak)) uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t *record, uint16_t prev_keycode) {
+    if (is_flow_tap_key(keycode) && is_flow_tap_key(prev_keycode)) {
+        return FLOW_TAP_TERM;
+    }
+    return 0;
+}
+#endif
+
+// Keymaps without a chordal_hold_layout get the split default: rows of the
+// left half are 'L', rows of the right half are 'R'.
+__attribute__((weak)) const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS] = {
+    {'L', 'L', 'L', 'L', 'L', 'L'}, {'L', 'L', 'L', 'L', 'L', 'L'}, {'L', 'L', 'L', 'L', 'L', 'L'}, {'L', 'L', 'L', 'L', 'L', 'L'},
+    {'R', 'R', 'R', 'R', 'R', 'R'}, {'R', 'R', 'R', 'R', 'R', 'R'}, {'R', 'R', 'R', 'R', 'R', 'R'}, {'R', 'R', 'R', 'R', 'R', 'R'},
+};
+
+__attribute__((weak)) char chordal_hold_handedness(keypos_t key) {
+    return (char)pgm_read_byte(&chordal_hold_layout[key.row][key.col]);
+}
+
+__attribute__((weak)) bool get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record, uint16_t other_keycode, keyrecord_t *other_record) {
+    if (tap_hold_record->event.type != KEY_EVENT || other_record->event.type != KEY_EVENT) {
+        return true;  // Return true on combos or other non-key events.
+    }
+    char tap_hold_hand = chordal_hold_handedness(tap_hold_record->event.key);
+    if (tap_hold_hand == '*') {
+        return true;
+    }
+    char other_hand = chordal_hold_handedness(other_record->event.key);
+    return other_hand == '*' || tap_hold_hand != other_hand;
+}
+
+__attribute__((weak)) bool get_speculative_hold(uint16_t keycode, keyrecord_t *record) {
+    const uint8_t mods = QK_MOD_TAP_GET_MODS(keycode);
+    return (mods & (MOD_LCTL | MOD_LSFT)) == (mods & MOD_HYPR);
+}
+
+/* Layout */
+
+// clang-format off
+static const uint8_t layout_index[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_split_3x6_3(
+     1,  2,  3,  4,  5,  6,     7,  8,  9, 10, 11, 12,
+    13, 14, 15, 16, 17, 18,    19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30,    31, 32, 33, 34, 35, 36,
+                37, 38, 39,    40, 41, 42
+);
+// clang-format on
+
+bool sim_layout_to_matrix(uint8_t index, uint8_t *row, uint8_t *col) {
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
+            if (layout_index[r][c] == index + 1) {
+                *row = r;
+                *col = c;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint8_t sim_matrix_to_layout(uint8_t row, uint8_t col) {
+    return layout_index[row][col] - 1;
+}
+
+/* Keyboard task */
+
+void sim_set_scan_rate(uint32_t hz) {
+    scan_period_us = hz ? 1000000 / hz : 0;
+}
+
+uint64_t sim_next_deadline_us(void) {
+    uint64_t deadline = sim_action_deadline_us();
+    uint64_t t;
+    if ((t = sim_combo_deadline_us()) < deadline) {
+        deadline = t;
+    }
+    if ((t = sim_tap_dance_deadline_us()) < deadline) {
+        deadline = t;
+    }
+    if ((t = sim_caps_word_deadline_us()) < deadline) {
+        deadline = t;
+    }
+    if ((t = sim_deferred_exec_deadline_us()) < deadline) {
+        deadline = t;
+    }
+    if (scan_period_us) {
+        t = (sim_time_us() / scan_period_us + 1) * scan_period_us;
+        if (t < deadline) {
+            deadline = t;
+        }
+    }
+    return deadline;
+}
+
+void sim_task(void) {
+    matrix_scan_user();
+    sim_action_task();
+    combo_task();
+    tap_dance_task();
+    caps_word_task();
+    housekeeping_task_user();
+    deferred_exec_task();
+}
+
+void sim_run_until(uint64_t t) {
+    uint64_t last_run = SIM_NO_DEADLINE;
+    for (;;) {
+        uint64_t deadline = sim_next_deadline_us();
+        if (deadline <= last_run && last_run != SIM_NO_DEADLINE) {
+            // Nothing moved the deadline; step past it to guarantee progress.
+            deadline = last_run + 1000;
+        }
+        if (deadline > t) {
+            break;
+        }
+        sim_set_time_us(deadline);
+        last_run = sim_time_us();
+        sim_task();
+    }
+    sim_set_time_us(t);
+}
+
+void sim_key_event(uint8_t row, uint8_t col, bool pressed) {
+    sim_activity_trigger();
+    sim_stats.events++;
+    action_exec(MAKE_KEYEVENT(row, col, pressed));
+    sim_task();
+}
+
+void sim_init(void) {
+    sim_report_reset();
+    sim_action_reset();
+    sim_combo_reset();
+    sim_tap_dance_reset();
+    sim_caps_word_reset();
+    sim_unicode_reset();
+    sim_deferred_exec_reset();
+    memset(&sim_stats, 0, sizeof(sim_stats));
+    sim_eeconfig_reset();
+    keyboard_pre_init_user();
+    keyboard_post_init_user();
+}
@@ -0,0 +1,347 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Subset of QMK's keycodes.h and quantum_keycodes.h used by this keymap. The
+// values match upstream QMK so that range checks and switch statements in the
+// keymap behave exactly as on the board.
+
+#pragma once
+
+#include <stdint.h>
+
+enum basic_keycodes {
+    KC_NO   = 0x0000,
+    KC_TRNS = 0x0001,
+    KC_A    = 0x0004,
+    KC_B,
+    KC_C,
+    KC_D,
+    KC_E,
+    KC_F,
+    KC_G,
+    KC_H,
+    KC_I,
+    KC_J,
+    KC_K,
+    KC_L,
+    KC_M,
+    KC_N,
+    KC_O,
+    KC_P,
+    KC_Q,
+    KC_R,
+    KC_S,
+    KC_T,
+    KC_U,
+    KC_V,
+    KC_W,
+    KC_X,
+    KC_Y,
+    KC_Z,
+    KC_1,
+    KC_2,
+    KC_3,
+    KC_4,
+    KC_5,
+    KC_6,
+    KC_7,
+    KC_8,
+    KC_9,
+    KC_0,
+    KC_ENTER,
+    KC_ESCAPE,
+    KC_BACKSPACE,
+    KC_TAB,
+    KC_SPACE,
+    KC_MINUS,
+    KC_EQUAL,
+    KC_LEFT_BRACKET,
+    KC_RIGHT_BRACKET,
+    KC_BACKSLASH,
+    KC_NONUS_HASH,
+    KC_SEMICOLON,
+    KC_QUOTE,
+    KC_GRAVE,
+    KC_COMMA,
+    KC_DOT,
+    KC_SLASH,
+    KC_CAPS_LOCK,
+    KC_F1,
+    KC_F2,
+    KC_F3,
+    KC_F4,
+    KC_F5,
+    KC_F6,
+    KC_F7,
+    KC_F8,
+    KC_F9,
+    KC_F10,
+    KC_F11,
+    KC_F12,
+    KC_PRINT_SCREEN,
+    KC_SCROLL_LOCK,
+    KC_PAUSE,
+    KC_INSERT,
+    KC_HOME,
+    KC_PAGE_UP,
+    KC_DELETE,
+    KC_END,
+    KC_PAGE_DOWN,
+    KC_RIGHT,
+    KC_LEFT,
+    KC_DOWN,
+    KC_UP,
+
+    KC_SYSTEM_POWER        = 0x00A5,
+    KC_SYSTEM_SLEEP        = 0x00A6,
+    KC_SYSTEM_WAKE         = 0x00A7,
+    KC_AUDIO_MUTE          = 0x00A8,
+    KC_AUDIO_VOL_UP        = 0x00A9,
+    KC_AUDIO_VOL_DOWN      = 0x00AA,
+    KC_MEDIA_NEXT_TRACK    = 0x00AB,
+    KC_MEDIA_PREV_TRACK    = 0x00AC,
+    KC_MEDIA_STOP          = 0x00AD,
+    KC_MEDIA_PLAY_PAUSE    = 0x00AE,
+    KC_BRIGHTNESS_UP       = 0x00BD,
+    KC_BRIGHTNESS_DOWN     = 0x00BE,
+
+    KC_LEFT_CTRL           = 0x00E0,
+    KC_LEFT_SHIFT,
+    KC_LEFT_ALT,
+    KC_LEFT_GUI,
+    KC_RIGHT_CTRL,
+    KC_RIGHT_SHIFT,
+    KC_RIGHT_ALT,
+    KC_RIGHT_GUI,
+};
+
+enum quantum_keycodes {
+    QK_BASIC                = 0x0000,
+    QK_BASIC_MAX            = 0x00FF,
+    QK_MODS                 = 0x0100,
+    QK_MODS_MAX             = 0x1FFF,
+    QK_MOD_TAP              = 0x2000,
+    QK_MOD_TAP_MAX          = 0x3FFF,
+    QK_LAYER_TAP            = 0x4000,
+    QK_LAYER_TAP_MAX        = 0x4FFF,
+    QK_LAYER_MOD            = 0x5000,
+    QK_LAYER_MOD_MAX        = 0x51FF,
+    QK_TO                   = 0x5200,
+    QK_TO_MAX               = 0x521F,
+    QK_MOMENTARY            = 0x5220,
+    QK_MOMENTARY_MAX        = 0x523F,
+    QK_DEF_LAYER            = 0x5240,
+    QK_DEF_LAYER_MAX        = 0x525F,
+    QK_TOGGLE_LAYER         = 0x5260,
+    QK_TOGGLE_LAYER_MAX     = 0x527F,
+    QK_ONE_SHOT_LAYER       = 0x5280,
+    QK_ONE_SHOT_LAYER_MAX   = 0x529F,
+    QK_ONE_SHOT_MOD         = 0x52A0,
+    QK_ONE_SHOT_MOD_MAX     = 0x52BF,
+    QK_LAYER_TAP_TOGGLE     = 0x52C0,
+    QK_LAYER_TAP_TOGGLE_MAX = 0x52DF,
+    QK_TAP_DANCE            = 0x5700,
+    QK_TAP_DANCE_MAX        = 0x57FF,
+    QK_BOOTLOADER           = 0x7C00,
+    QK_REBOOT               = 0x7C01,
+    QK_CAPS_WORD_TOGGLE     = 0x7C73,
+    QK_REPEAT_KEY           = 0x7C79,
+    QK_ALT_REPEAT_KEY       = 0x7C7A,
+    QK_LAYER_LOCK           = 0x7C7B,
+    QK_KB                   = 0x7E00,
+    QK_USER                 = 0x7E40,
+    QK_USER_MAX             = 0x7FFF,
+    QK_UNICODEMAP           = 0x8000,
+    QK_UNICODEMAP_MAX       = 0xBFFF,
+    QK_UNICODEMAP_PAIR      = 0xC000,
+    QK_UNICODEMAP_PAIR_MAX  = 0xFFFF,
+};
+
+#define SAFE_RANGE QK_USER
+
+// Short names
+#define XXXXXXX KC_NO
+#define _______ KC_TRNS
+#define KC_TRANSPARENT KC_TRNS
+#define KC_ENT KC_ENTER
+#define KC_ESC KC_ESCAPE
+#define KC_BSPC KC_BACKSPACE
+#define KC_SPC KC_SPACE
+#define KC_MINS KC_MINUS
+#define KC_EQL KC_EQUAL
+#define KC_LBRC KC_LEFT_BRACKET
+#define KC_RBRC KC_RIGHT_BRACKET
+#define KC_BSLS KC_BACKSLASH
+#define KC_NUHS KC_NONUS_HASH
+#define KC_SCLN KC_SEMICOLON
+#define KC_QUOT KC_QUOTE
+#define KC_GRV KC_GRAVE
+#define KC_COMM KC_COMMA
+#define KC_SLSH KC_SLASH
+#define KC_CAPS KC_CAPS_LOCK
+#define KC_PSCR KC_PRINT_SCREEN
+#define KC_INS KC_INSERT
+#define KC_PGUP KC_PAGE_UP
+#define KC_DEL KC_DELETE
+#define KC_PGDN KC_PAGE_DOWN
+#define KC_RGHT KC_RIGHT
+#define KC_PWR KC_SYSTEM_POWER
+#define KC_SLEP KC_SYSTEM_SLEEP
+#define KC_WAKE KC_SYSTEM_WAKE
+#define KC_MUTE KC_AUDIO_MUTE
+#define KC_VOLU KC_AUDIO_VOL_UP
+#define KC_VOLD KC_AUDIO_VOL_DOWN
+#define KC_MNXT KC_MEDIA_NEXT_TRACK
+#define KC_MPRV KC_MEDIA_PREV_TRACK
+#define KC_MSTP KC_MEDIA_STOP
+#define KC_MPLY KC_MEDIA_PLAY_PAUSE
+#define KC_BRIU KC_BRIGHTNESS_UP
+#define KC_BRID KC_BRIGHTNESS_DOWN
+#define KC_LCTL KC_LEFT_CTRL
+#define KC_LSFT KC_LEFT_SHIFT
+#define KC_LALT KC_LEFT_ALT
+#define KC_LGUI KC_LEFT_GUI
+#define KC_RCTL KC_RIGHT_CTRL
+#define KC_RSFT KC_RIGHT_SHIFT
+#define KC_RALT KC_RIGHT_ALT
+#define KC_RGUI KC_RIGHT_GUI
+
+#define QK_BOOT QK_BOOTLOADER
+#define QK_RBT QK_REBOOT
+#define CW_TOGG QK_CAPS_WORD_TOGGLE
+#define QK_REP QK_REPEAT_KEY
+#define QK_AREP QK_ALT_REPEAT_KEY
+#define QK_LLCK QK_LAYER_LOCK
+
+// Modifier bits as packed into 16-bit keycodes (5 bits, bit 4 = right hand)
+enum mods_5bit {
+    MOD_LCTL = 0x01,
+    MOD_LSFT = 0x02,
+    MOD_LALT = 0x04,
+    MOD_LGUI = 0x08,
+    MOD_RCTL = 0x11,
+    MOD_RSFT = 0x12,
+    MOD_RALT = 0x14,
+    MOD_RGUI = 0x18,
+};
+#define MOD_HYPR (MOD_LCTL | MOD_LSFT | MOD_LALT | MOD_LGUI)
+#define MOD_MEH (MOD_LCTL | MOD_LSFT | MOD_LALT)
+
+// Modifier bits as they appear in the HID report (8 bits)
+#define MOD_BIT(code) (1 << ((code)&0x07))
+#define MOD_BIT_LCTRL MOD_BIT(KC_LEFT_CTRL)
+#define MOD_BIT_LSHIFT MOD_BIT(KC_LEFT_SHIFT)
+#define MOD_BIT_LALT MOD_BIT(KC_LEFT_ALT)
+#define MOD_BIT_LGUI MOD_BIT(KC_LEFT_GUI)
+#define MOD_BIT_RCTRL MOD_BIT(KC_RIGHT_CTRL)
+#define MOD_BIT_RSHIFT MOD_BIT(KC_RIGHT_SHIFT)
+#define MOD_BIT_RALT MOD_BIT(KC_RIGHT_ALT)
+#define MOD_BIT_RGUI MOD_BIT(KC_RIGHT_GUI)
+#define MOD_MASK_CTRL (MOD_BIT_LCTRL | MOD_BIT_RCTRL)
+#define MOD_MASK_SHIFT (MOD_BIT_LSHIFT | MOD_BIT_RSHIFT)
+#define MOD_MASK_ALT (MOD_BIT_LALT | MOD_BIT_RALT)
+#define MOD_MASK_GUI (MOD_BIT_LGUI | MOD_BIT_RGUI)
+#define MOD_MASK_CS (MOD_MASK_CTRL | MOD_MASK_SHIFT)
+#define MOD_MASK_CA (MOD_MASK_CTRL | MOD_MASK_ALT)
+#define MOD_MASK_CG (MOD_MASK_CTRL | MOD_MASK_GUI)
+#define MOD_MASK_SA (MOD_MASK_SHIFT | MOD_MASK_ALT)
+
+// Converts packed 5-bit mods to HID report mods.
+#define MOD5_TO_MOD8(mods) ((uint8_t)(((mods)&0x10) ? (((mods)&0x0F) << 4) : ((mods)&0x0F)))
+
+// Modified keycodes
+#define QK_LCTL 0x0100
+#define QK_LSFT 0x0200
+#define QK_LALT 0x0400
+#define QK_LGUI 0x0800
+#define QK_RMODS_MIN 0x1000
+#define QK_RCTL 0x1100
+#define QK_RSFT 0x1200
+#define QK_RALT 0x1400
+#define QK_RGUI 0x1800
+
+#define LCTL(kc) (QK_LCTL | (kc))
+#define LSFT(kc) (QK_LSFT | (kc))
+#define LALT(kc) (QK_LALT | (kc))
+#define LGUI(kc) (QK_LGUI | (kc))
+#define RCTL(kc) (QK_RCTL | (kc))
+#define RSFT(kc) (QK_RSFT | (kc))
+#define RALT(kc) (QK_RALT | (kc))
+#define RGUI(kc) (QK_RGUI | (kc))
+#define S(kc) LSFT(kc)
+#define C(kc) LCTL(kc)
+#define A(kc) LALT(kc)
+#define G(kc) LGUI(kc)
+#define ALGR(kc) RALT(kc)
+
+#define KC_TILD S(KC_GRV)
+#define KC_EXLM S(KC_1)
+#define KC_AT S(KC_2)
+#define KC_HASH S(KC_3)
+#define KC_DLR S(KC_4)
+#define KC_PERC S(KC_5)
+#define KC_CIRC S(KC_6)
+#define KC_AMPR S(KC_7)
+#define KC_ASTR S(KC_8)
+#define KC_LPRN S(KC_9)
+#define KC_RPRN S(KC_0)
+#define KC_UNDS S(KC_MINS)
+#define KC_PLUS S(KC_EQL)
+#define KC_LCBR S(KC_LBRC)
+#define KC_RCBR S(KC_RBRC)
+#define KC_PIPE S(KC_BSLS)
+#define KC_COLN S(KC_SCLN)
+#define KC_DQUO S(KC_QUOT)
+#define KC_LABK S(KC_COMM)
+#define KC_RABK S(KC_DOT)
+#define KC_QUES S(KC_SLSH)
+
+// Tap-hold, layer and one-shot keycodes
+#define MT(mod, kc) (QK_MOD_TAP | (((mod)&0x1F) << 8) | ((kc)&0xFF))
+#define LCTL_T(kc) MT(MOD_LCTL, kc)
+#define LSFT_T(kc) MT(MOD_LSFT, kc)
+#define LALT_T(kc) MT(MOD_LALT, kc)
+#define LGUI_T(kc) MT(MOD_LGUI, kc)
+#define RCTL_T(kc) MT(MOD_RCTL, kc)
+#define RSFT_T(kc) MT(MOD_RSFT, kc)
+#define RALT_T(kc) MT(MOD_RALT, kc)
+#define RGUI_T(kc) MT(MOD_RGUI, kc)
+#define LT(layer, kc) (QK_LAYER_TAP | (((layer)&0xF) << 8) | ((kc)&0xFF))
+#define TO(layer) (QK_TO | ((layer)&0x1F))
+#define MO(layer) (QK_MOMENTARY | ((layer)&0x1F))
+#define DF(layer) (QK_DEF_LAYER | ((layer)&0x1F))
+#define TG(layer) (QK_TOGGLE_LAYER | ((layer)&0x1F))
+#define OSL(layer) (QK_ONE_SHOT_LAYER | ((layer)&0x1F))
+#define OSM(mod) (QK_ONE_SHOT_MOD | ((mod)&0x1F))
+#define TD(n) (QK_TAP_DANCE | ((n)&0xFF))
+#define UM(i) (QK_UNICODEMAP | ((i)&0x3FFF))
+#define UP(i, j) (QK_UNICODEMAP_PAIR | ((i)&0x7F) | (((j)&0x7F) << 7))
+
+#define IS_QK_BASIC(code) ((code) >= QK_BASIC && (code) <= QK_BASIC_MAX)
+#define IS_QK_MODS(code) ((code) >= QK_MODS && (code) <= QK_MODS_MAX)
+#define IS_QK_MOD_TAP(code) ((code) >= QK_MOD_TAP && (code) <= QK_MOD_TAP_MAX)
+#define IS_QK_LAYER_TAP(code) ((code) >= QK_LAYER_TAP && (code) <= QK_LAYER_TAP_MAX)
+#define IS_QK_TO(code) ((code) >= QK_TO && (code) <= QK_TO_MAX)
+#define IS_QK_MOMENTARY(code) ((code) >= QK_MOMENTARY && (code) <= QK_MOMENTARY_MAX)
+#define IS_QK_ONE_SHOT_LAYER(code) ((code) >= QK_ONE_SHOT_LAYER && (code) <= QK_ONE_SHOT_LAYER_MAX)
+#define IS_QK_ONE_SHOT_MOD(code) ((code) >= QK_ONE_SHOT_MOD && (code) <= QK_ONE_SHOT_MOD_MAX)
+#define IS_QK_TAP_DANCE(code) ((code) >= QK_TAP_DANCE && (code) <= QK_TAP_DANCE_MAX)
+#define IS_QK_USER(code) ((code) >= QK_USER && (code) <= QK_USER_MAX)
+#define IS_QK_UNICODEMAP(code) ((code) >= QK_UNICODEMAP && (code) <= QK_UNICODEMAP_MAX)
+#define IS_QK_UNICODEMAP_PAIR(code) ((code) >= QK_UNICODEMAP_PAIR && (code) <= QK_UNICODEMAP_PAIR_MAX)
+#define IS_MODIFIER_KEYCODE(code) ((code) >= KC_LEFT_CTRL && (code) <= KC_RIGHT_GUI)
+
+#define QK_MODS_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MODS_GET_BASIC_KEYCODE(kc) ((kc)&0xFF)
+#define QK_MOD_TAP_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MOD_TAP_GET_TAP_KEYCODE(kc) ((kc)&0xFF)
+#define QK_LAYER_TAP_GET_LAYER(kc) (((kc) >> 8) & 0xF)
+#define QK_LAYER_TAP_GET_TAP_KEYCODE(kc) ((kc)&0xFF)
+#define QK_TO_GET_LAYER(kc) ((kc)&0x1F)
+#define QK_MOMENTARY_GET_LAYER(kc) ((kc)&0x1F)
+#define QK_ONE_SHOT_LAYER_GET_LAYER(kc) ((kc)&0x1F)
+#define QK_ONE_SHOT_MOD_GET_MODS(kc) ((kc)&0x1F)
+#define QK_TAP_DANCE_GET_INDEX(kc) ((kc)&0xFF)
+#define QK_UNICODEMAP_GET_INDEX(kc) ((kc)&0x3FFF)
+#define QK_UNICODEMAP_PAIR_GET_UNSHIFTED_INDEX(kc) ((kc)&0x7F)
+#define QK_UNICODEMAP_PAIR_GET_SHIFTED_INDEX(kc) (((kc) >> 7) & 0x7F)
@@ -0,0 +1,106 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// EurKEY aliases used by the keymap, following QMK's keymap_eurkey.h. The
+// simulator only needs the keycodes to be distinct and to carry the right
+// modifiers; the glyph comments document what the host produces.
+
+#pragma once
+
+#include "keycodes.h"
+
+// Row 1
+#define EU_GRV  KC_GRV  // `
+#define EU_MINS KC_MINS // -
+#define EU_EQL  KC_EQL  // =
+// Row 2
+#define EU_LBRC KC_LBRC // [
+#define EU_RBRC KC_RBRC // ]
+#define EU_BSLS KC_BSLS // (backslash)
+// Row 3
+#define EU_SCLN KC_SCLN // ;
+#define EU_QUOT KC_QUOT // '
+// Row 4
+#define EU_COMM KC_COMM // ,
+#define EU_DOT  KC_DOT  // .
+#define EU_SLSH KC_SLSH // /
+
+// Shifted symbols
+#define EU_TILD S(EU_GRV)  // ~
+#define EU_EXLM S(KC_1)    // !
+#define EU_AT   S(KC_2)    // @
+#define EU_HASH S(KC_3)    // #
+#define EU_DLR  S(KC_4)    // $
+#define EU_PERC S(KC_5)    // %
+#define EU_CIRC S(KC_6)    // ^
+#define EU_AMPR S(KC_7)    // &
+#define EU_ASTR S(KC_8)    // *
+#define EU_LPRN S(KC_9)    // (
+#define EU_RPRN S(KC_0)    // )
+#define EU_UNDS S(EU_MINS) // _
+#define EU_PLUS S(EU_EQL)  // +
+#define EU_LCBR S(EU_LBRC) // {
+#define EU_RCBR S(EU_RBRC) // }
+#define EU_PIPE S(EU_BSLS) // |
+#define EU_COLN S(EU_SCLN) // :
+#define EU_DQUO S(EU_QUOT) // "
+#define EU_LABK S(EU_COMM) // <
+#define EU_RABK S(EU_DOT)  // >
+#define EU_QUES S(EU_SLSH) // ?
+
+// AltGr symbols
+#define EU_DGRV ALGR(EU_GRV)  // ` (dead)
+#define EU_IEXL ALGR(KC_1)    // ¡
+#define EU_FORD ALGR(KC_2)    // ª
+#define EU_MORD ALGR(KC_3)    // º
+#define EU_PND  ALGR(KC_4)    // £
+#define EU_EURO ALGR(KC_5)    // €
+#define EU_DCIR ALGR(KC_6)    // ^ (dead)
+#define EU_RNGA ALGR(KC_7)    // ˚ (dead)
+#define EU_DLQU ALGR(KC_8)    // „
+#define EU_LDQU ALGR(KC_9)    // “
+#define EU_RDQU ALGR(KC_0)    // ”
+#define EU_NDSH ALGR(EU_MINS) // –
+#define EU_MUL  ALGR(EU_EQL)  // ×
+#define EU_AE   ALGR(KC_Q)    // æ
+#define EU_ARNG ALGR(KC_W)    // å
+#define EU_EDIA ALGR(KC_E)    // ë
+#define EU_YDIA ALGR(KC_R)    // ÿ
+#define EU_THRN ALGR(KC_T)    // þ
+#define EU_UDIA ALGR(KC_Y)    // ü
+#define EU_IDIA ALGR(KC_I)    // ï
+#define EU_ODIA ALGR(KC_O)    // ö
+#define EU_OE   ALGR(KC_P)    // œ
+#define EU_LDAQ ALGR(EU_LBRC) // «
+#define EU_RDAQ ALGR(EU_RBRC) // »
+#define EU_NOT  ALGR(EU_BSLS) // ¬
+#define EU_ADIA ALGR(KC_A)    // ä
+#define EU_SS   ALGR(KC_S)    // ß
+#define EU_ETH  ALGR(KC_D)    // ð
+#define EU_EGRV ALGR(KC_F)    // è
+#define EU_EACU ALGR(KC_G)    // é
+#define EU_UGRV ALGR(KC_H)    // ù
+#define EU_UACU ALGR(KC_J)    // ú
+#define EU_IJ   ALGR(KC_K)    // ĳ
+#define EU_OSTR ALGR(KC_L)    // ø
+#define EU_DEG  ALGR(EU_SCLN) // °
+#define EU_ACUT ALGR(EU_QUOT) // ´ (dead)
+#define EU_AGRV ALGR(KC_Z)    // à
+#define EU_AACU ALGR(KC_X)    // á
+#define EU_CCED ALGR(KC_C)    // ç
+#define EU_IGRV ALGR(KC_V)    // ì
+#define EU_IACU ALGR(KC_B)    // í
+#define EU_NTIL ALGR(KC_N)    // ñ
+#define EU_DGRK ALGR(KC_M)    // Greek (dead)
+#define EU_LSQU ALGR(EU_COMM) // ‘
+#define EU_RSQU ALGR(EU_DOT)  // ’
+#define EU_IQUE ALGR(EU_SLSH) // ¿
+
+// Shift+AltGr symbols
+#define EU_DTIL S(ALGR(EU_GRV))  // ~ (dead)
+#define EU_SUP1 S(ALGR(KC_1))    // ¹
+#define EU_SECT S(ALGR(KC_3))    // §
+#define EU_CARN S(ALGR(KC_6))    // ˇ (dead)
+#define EU_DIAE S(ALGR(EU_QUOT)) // ¨ (dead)
+#define EU_ELLP S(ALGR(EU_DOT))  // …
+#define EU_MDDT S(ALGR(EU_COMM)) // ·
@@ -0,0 +1,362 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Host-side stand-in for QMK's quantum.h. It declares the slice of the QMK API
+// that the keymap and its features use, with the same names and semantics, so
+// keymap.c compiles unchanged against the simulator.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "keycodes.h"
+
+// Keyboard geometry (cantor: split 3x6+3 on a direct-pin matrix)
+#define MATRIX_ROWS 8
+#define MATRIX_COLS 6
+
+// Defaults from QMK for options the keymap config.h does not set
+#ifndef TAPPING_TERM
+#    define TAPPING_TERM 200
+#endif
+#ifndef COMBO_TERM
+#    define COMBO_TERM 50
+#endif
+#ifndef TAP_CODE_DELAY
+#    define TAP_CODE_DELAY 0
+#endif
+#ifndef UNICODE_TYPE_DELAY
+#    define UNICODE_TYPE_DELAY 10
+#endif
+#ifndef CAPS_WORD_IDLE_TIMEOUT
+#    define CAPS_WORD_IDLE_TIMEOUT 5000
+#endif
+#ifndef MAX_DEFERRED_EXECUTORS
+#    define MAX_DEFERRED_EXECUTORS 8
+#endif
+#ifndef TAP_DANCE_MAX_SIMULTANEOUS
+#    define TAP_DANCE_MAX_SIMULTANEOUS 3
+#endif
+
+// Flash access is plain memory access on the host
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+#define pgm_read_dword(address) (*(const uint32_t *)(address))
+#define memcpy_P(dest, src, n) memcpy((dest), (src), (n))
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+// Console output is discarded unless the simulator is asked for it
+void sim_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+#define dprintf(...) sim_printf(__VA_ARGS__)
+#define uprintf(...) sim_printf(__VA_ARGS__)
+
+/* Timer */
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+#define TIMER_DIFF_16(a, b) (uint16_t)((a) - (b))
+#define TIMER_DIFF_32(a, b) (uint32_t)((a) - (b))
+void wait_ms(uint32_t ms);
+void wait_us(uint32_t us);
+
+/* Events and records */
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef enum keyevent_type_t {
+    TICK_EVENT  = 0,
+    KEY_EVENT   = 1,
+    ENCODER_CW_EVENT,
+    ENCODER_CCW_EVENT,
+    COMBO_EVENT = 4,
+} keyevent_type_t;
+
+typedef struct {
+    keypos_t        key;
+    uint16_t        time;
+    keyevent_type_t type;
+    bool            pressed;
+} keyevent_t;
+
+typedef struct {
+    bool    interrupted : 1;
+    bool    reserved2 : 1;
+    bool    reserved1 : 1;
+    bool    reserved0 : 1;
+    uint8_t count : 4;
+} tap_t;
+
+typedef struct {
+    keyevent_t event;
+    tap_t      tap;
+    uint16_t   keycode;
+} keyrecord_t;
+
+#define KEYLOC_COMBO 254
+#define KEYEQ(keya, keyb) ((keya).row == (keyb).row && (keya).col == (keyb).col)
+#define IS_NOEVENT(event) ((event).type == TICK_EVENT)
+#define IS_EVENT(event) ((event).type != TICK_EVENT)
+#define IS_KEYEVENT(event) ((event).type == KEY_EVENT)
+#define MAKE_KEYEVENT(row_num, col_num, press) ((keyevent_t){.key = ((keypos_t){.col = (col_num), .row = (row_num)}), .pressed = (press), .time = (timer_read() | 1), .type = KEY_EVENT})
+#define MAKE_COMBOEVENT(press) ((keyevent_t){.key = ((keypos_t){.col = KEYLOC_COMBO, .row = KEYLOC_COMBO}), .pressed = (press), .time = (timer_read() | 1), .type = COMBO_EVENT})
+
+void     action_exec(keyevent_t event);
+void     process_record(keyrecord_t *record);
+void     action_tapping_process(keyrecord_t record);
+uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
+uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+uint8_t  keymap_layer_count(void);
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column);
+
+/* Layers */
+typedef uint32_t layer_state_t;
+#define MAX_LAYER 32
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+
+void    layer_state_set(layer_state_t state);
+bool    layer_state_is(uint8_t layer);
+bool    layer_state_cmp(layer_state_t cmp_layer_state, uint8_t layer);
+void    layer_clear(void);
+void    layer_move(uint8_t layer);
+void    layer_on(uint8_t layer);
+void    layer_off(uint8_t layer);
+void    layer_invert(uint8_t layer);
+void    default_layer_set(layer_state_t state);
+uint8_t get_highest_layer(layer_state_t state);
+uint8_t layer_switch_get_layer(keypos_t key);
+void    update_source_layers_cache(keypos_t key, uint8_t layer);
+uint8_t read_source_layers_cache(keypos_t key);
+#define IS_LAYER_ON(layer) layer_state_is(layer)
+#define IS_LAYER_OFF(layer) (!layer_state_is(layer))
+
+layer_state_t layer_state_set_user(layer_state_t state);
+layer_state_t default_layer_state_set_user(layer_state_t state);
+
+bool is_layer_locked(uint8_t layer);
+void layer_lock_on(uint8_t layer);
+void layer_lock_off(uint8_t layer);
+void layer_lock_invert(uint8_t layer);
+void layer_lock_all_off(void);
+
+enum { ONESHOT_PRESSED = 0b01, ONESHOT_OTHER_KEY_PRESSED = 0b10, ONESHOT_START = 0b11 };
+void    set_oneshot_layer(uint8_t layer, uint8_t state);
+void    clear_oneshot_layer_state(uint8_t state);
+bool    is_oneshot_layer_active(void);
+uint8_t get_oneshot_layer(void);
+
+/* Mods and keyboard report */
+#define KEYBOARD_REPORT_KEYS 6
+
+typedef struct {
+    uint8_t mods;
+    uint8_t reserved;
+    uint8_t keys[KEYBOARD_REPORT_KEYS];
+} report_keyboard_t;
+
+typedef union {
+    uint8_t raw;
+    struct {
+        bool num_lock : 1;
+        bool caps_lock : 1;
+        bool scroll_lock : 1;
+        bool compose : 1;
+        bool kana : 1;
+        uint8_t reserved : 3;
+    };
+} led_t;
+
+typedef struct {
+    uint8_t (*keyboard_leds)(void);
+    void (*send_keyboard)(report_keyboard_t *);
+    void (*send_nkro)(void *);
+    void (*send_mouse)(void *);
+    void (*send_extra)(uint8_t report_id, uint16_t usage);
+} host_driver_t;
+
+enum { REPORT_ID_SYSTEM = 3, REPORT_ID_CONSUMER = 4 };
+
+extern report_keyboard_t *keyboard_report;
+
+void           host_set_driver(host_driver_t *driver);
+host_driver_t *host_get_driver(void);
+void           host_keyboard_send(report_keyboard_t *report);
+void           host_system_send(uint16_t usage);
+void           host_consumer_send(uint16_t usage);
+led_t          host_keyboard_led_state(void);
+
+uint8_t get_mods(void);
+void    add_mods(uint8_t mods);
+void    del_mods(uint8_t mods);
+void    set_mods(uint8_t mods);
+void    clear_mods(void);
+void    register_mods(uint8_t mods);
+void    unregister_mods(uint8_t mods);
+uint8_t get_weak_mods(void);
+void    add_weak_mods(uint8_t mods);
+void    del_weak_mods(uint8_t mods);
+void    set_weak_mods(uint8_t mods);
+void    clear_weak_mods(void);
+void    register_weak_mods(uint8_t mods);
+void    unregister_weak_mods(uint8_t mods);
+uint8_t get_oneshot_mods(void);
+void    add_oneshot_mods(uint8_t mods);
+void    del_oneshot_mods(uint8_t mods);
+void    set_oneshot_mods(uint8_t mods);
+void    clear_oneshot_mods(void);
+
+void add_key(uint8_t key);
+void del_key(uint8_t key);
+void clear_keys(void);
+bool has_anykey(void);
+void clear_keyboard(void);
+void send_keyboard_report(void);
+
+void register_code(uint8_t code);
+void unregister_code(uint8_t code);
+void tap_code(uint8_t code);
+void tap_code_delay(uint8_t code, uint16_t delay);
+void register_code16(uint16_t code);
+void unregister_code16(uint16_t code);
+void tap_code16(uint16_t code);
+void tap_code16_delay(uint16_t code, uint16_t delay);
+
+/* Send string */
+extern const uint8_t ascii_to_keycode_lut[128];
+extern const uint8_t ascii_to_shift_lut[16];
+void send_char(char ascii_code);
+void send_string(const char *string);
+void send_string_P(const char *string);
+#define SEND_STRING(string) send_string_P(PSTR(string))
+
+/* Tap-hold decisions */
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
+uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t *record, uint16_t prev_keycode);
+bool     is_flow_tap_key(uint16_t keycode);
+bool     get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record, uint16_t other_keycode, keyrecord_t *other_record);
+bool     get_speculative_hold(uint16_t keycode, keyrecord_t *record);
+char     chordal_hold_handedness(keypos_t key);
+extern const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS];
+
+/* Combos */
+#define COMBO_END 0
+typedef struct {
+    const uint16_t *keys;
+    uint16_t        keycode;
+} combo_t;
+#define COMBO(ck, ca) {.keys = &(ck)[0], .keycode = (ca)}
+extern combo_t key_combos[];
+uint16_t       combo_count(void);
+bool           combo_should_trigger(uint16_t combo_index, combo_t *combo, uint16_t keycode, keyrecord_t *record);
+
+/* Tap dance */
+typedef struct {
+    uint16_t interrupting_keycode;
+    uint8_t  count;
+    uint8_t  weak_mods;
+    uint8_t  oneshot_mods;
+    bool     pressed : 1;
+    bool     finished : 1;
+    bool     interrupted : 1;
+} tap_dance_state_t;
+
+typedef void (*tap_dance_user_fn_t)(tap_dance_state_t *state, void *user_data);
+
+typedef struct {
+    struct {
+        tap_dance_user_fn_t on_each_tap;
+        tap_dance_user_fn_t on_dance_finished;
+        tap_dance_user_fn_t on_reset;
+        tap_dance_user_fn_t on_each_release;
+    } fn;
+    void *user_data;
+} tap_dance_action_t;
+
+typedef struct {
+    uint16_t kc1;
+    uint16_t kc2;
+} tap_dance_pair_t;
+
+void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data);
+void tap_dance_pair_finished(tap_dance_state_t *state, void *user_data);
+void tap_dance_pair_reset(tap_dance_state_t *state, void *user_data);
+
+#define ACTION_TAP_DANCE_DOUBLE(kc1, kc2) \
+    { .fn = {tap_dance_pair_on_each_tap, tap_dance_pair_finished, tap_dance_pair_reset, NULL}, .user_data = (void *)&((tap_dance_pair_t){kc1, kc2}), }
+#define ACTION_TAP_DANCE_FN(user_fn) \
+    { .fn = {NULL, user_fn, NULL, NULL}, .user_data = NULL, }
+#define ACTION_TAP_DANCE_FN_ADVANCED(user_fn_on_each_tap, user_fn_on_dance_finished, user_fn_on_dance_reset) \
+    { .fn = {user_fn_on_each_tap, user_fn_on_dance_finished, user_fn_on_dance_reset, NULL}, .user_data = NULL, }
+
+extern tap_dance_action_t tap_dance_actions[];
+uint16_t                  tap_dance_count(void);
+tap_dance_state_t        *tap_dance_get_state(uint8_t tap_dance_idx);
+
+/* Caps Word */
+void caps_word_on(void);
+void caps_word_off(void);
+void caps_word_toggle(void);
+bool is_caps_word_on(void);
+bool caps_word_press_user(uint16_t keycode);
+void caps_word_set_user(bool active);
+
+/* Unicode */
+extern const uint32_t unicode_map[];
+void register_unicode(uint32_t code_point);
+void register_unicodemap(uint16_t index);
+void send_unicode_string(const char *str);
+void unicode_input_start(void);
+void unicode_input_finish(void);
+void register_hex32(uint32_t hex);
+
+/* Deferred execution */
+typedef uint8_t deferred_token;
+#define INVALID_DEFERRED_TOKEN 0
+typedef uint32_t (*deferred_exec_callback)(uint32_t trigger_time, void *cb_arg);
+deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg);
+bool           extend_deferred_exec(deferred_token token, uint32_t delay_ms);
+bool           cancel_deferred_exec(deferred_token token);
+
+/* Repeat Key */
+uint16_t get_last_keycode(void);
+uint8_t  get_last_mods(void);
+
+/* Bootloader and reboot */
+void reset_keyboard(void);
+void soft_reset_keyboard(void);
+
+/* Activity */
+uint32_t last_input_activity_time(void);
+uint32_t last_input_activity_elapsed(void);
+uint32_t last_matrix_activity_time(void);
+uint32_t last_matrix_activity_elapsed(void);
+
+/* EEPROM */
+#ifndef EECONFIG_USER_DATA_SIZE
+#    define EECONFIG_USER_DATA_SIZE 0
+#endif
+void     eeconfig_init_user(void);
+uint32_t eeconfig_read_user(void);
+void     eeconfig_update_user(uint32_t value);
+uint32_t eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t size);
+uint32_t eeconfig_update_user_datablock(const void *data, uint32_t offset, uint32_t size);
+
+/* User and keyboard hooks */
+void keyboard_pre_init_user(void);
+void keyboard_post_init_user(void);
+void matrix_scan_user(void);
+void housekeeping_task_user(void);
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record);
+bool process_record_user(uint16_t keycode, keyrecord_t *record);
+void post_process_record_user(uint16_t keycode, keyrecord_t *record);
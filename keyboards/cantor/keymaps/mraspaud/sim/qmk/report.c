@@ -0,0 +1,344 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Modifier state, the 6KRO keyboard report and the host driver, following
+// QMK's action_util.c, action.c and host.c.
+
+#include "sim.h"
+
+static uint8_t real_mods    = 0;
+static uint8_t weak_mods    = 0;
+static uint8_t oneshot_mods = 0;
+
+static report_keyboard_t report;
+static report_keyboard_t last_report;
+report_keyboard_t       *keyboard_report = &report;
+
+static sim_report_sink_t sink            = NULL;
+static void             *sink_arg        = NULL;
+static uint32_t          usb_interval_us = 1000;
+static uint64_t          usb_busy_until  = 0;
+
+void sim_report_reset(void) {
+    real_mods    = 0;
+    weak_mods    = 0;
+    oneshot_mods = 0;
+    memset(&report, 0, sizeof(report));
+    memset(&last_report, 0, sizeof(last_report));
+    usb_busy_until = 0;
+}
+
+void sim_set_report_sink(sim_report_sink_t new_sink, void *arg) {
+    sink     = new_sink;
+    sink_arg = arg;
+}
+
+void sim_set_usb_interval_us(uint32_t interval) {
+    usb_interval_us = interval;
+}
+
+// The USB stack blocks until the previous IN transfer is picked up by the
+// host, so back-to-back reports each cost one polling interval.
+void sim_report_emit(const sim_report_t *sim_report) {
+    if (sim_time_us() < usb_busy_until) {
+        sim_set_time_us(usb_busy_until);
+    }
+    sim_report_t out = *sim_report;
+    out.time_us      = sim_time_us();
+    usb_busy_until   = out.time_us + usb_interval_us;
+    if (sink != NULL) {
+        sink(&out, sink_arg);
+    }
+}
+
+/* Host driver */
+
+static uint8_t sim_keyboard_leds(void) {
+    return 0;
+}
+
+static void sim_send_keyboard(report_keyboard_t *keyboard) {
+    sim_report_t out = {.type = SIM_REPORT_KEYBOARD, .keyboard = *keyboard};
+    sim_report_emit(&out);
+}
+
+static void sim_send_extra(uint8_t report_id, uint16_t usage) {
+    sim_report_t out = {.type = report_id == REPORT_ID_SYSTEM ? SIM_REPORT_SYSTEM : SIM_REPORT_CONSUMER, .usage = usage};
+    sim_report_emit(&out);
+}
+
+static host_driver_t  sim_driver = {sim_keyboard_leds, sim_send_keyboard, NULL, NULL, sim_send_extra};
+static host_driver_t *driver     = &sim_driver;
+
+void host_set_driver(host_driver_t *new_driver) {
+    driver = new_driver;
+}
+
+host_driver_t *host_get_driver(void) {
+    return driver;
+}
+
+void host_keyboard_send(report_keyboard_t *keyboard) {
+    if (driver != NULL && driver->send_keyboard != NULL) {
+        driver->send_keyboard(keyboard);
+    }
+}
+
+void host_system_send(uint16_t usage) {
+    if (driver != NULL && driver->send_extra != NULL) {
+        driver->send_extra(REPORT_ID_SYSTEM, usage);
+    }
+}
+
+void host_consumer_send(uint16_t usage) {
+    if (driver != NULL && driver->send_extra != NULL) {
+        driver->send_extra(REPORT_ID_CONSUMER, usage);
+    }
+}
+
+led_t host_keyboard_led_state(void) {
+    led_t leds = {.raw = driver != NULL && driver->keyboard_leds != NULL ? driver->keyboard_leds() : 0};
+    return leds;
+}
+
+/* Modifiers */
+
+uint8_t get_mods(void) {
+    return real_mods;
+}
+void add_mods(uint8_t mods) {
+    real_mods |= mods;
+}
+void del_mods(uint8_t mods) {
+    real_mods &= ~mods;
+}
+void set_mods(uint8_t mods) {
+    real_mods = mods;
+}
+void clear_mods(void) {
+    real_mods = 0;
+}
+void register_mods(uint8_t mods) {
+    if (mods) {
+        add_mods(mods);
+        send_keyboard_report();
+    }
+}
+void unregister_mods(uint8_t mods) {
+    if (mods) {
+        del_mods(mods);
+        send_keyboard_report();
+    }
+}
+
+uint8_t get_weak_mods(void) {
+    return weak_mods;
+}
+void add_weak_mods(uint8_t mods) {
+    weak_mods |= mods;
+}
+void del_weak_mods(uint8_t mods) {
+    weak_mods &= ~mods;
+}
+void set_weak_mods(uint8_t mods) {
+    weak_mods = mods;
+}
+void clear_weak_mods(void) {
+    weak_mods = 0;
+}
+void register_weak_mods(uint8_t mods) {
+    if (mods) {
+        add_weak_mods(mods);
+        send_keyboard_report();
+    }
+}
+void unregister_weak_mods(uint8_t mods) {
+    if (mods) {
+        del_weak_mods(mods);
+        send_keyboard_report();
+    }
+}
+
+uint8_t get_oneshot_mods(void) {
+    return oneshot_mods;
+}
+void add_oneshot_mods(uint8_t mods) {
+    oneshot_mods |= mods;
+}
+void del_oneshot_mods(uint8_t mods) {
+    oneshot_mods &= ~mods;
+}
+void set_oneshot_mods(uint8_t mods) {
+    oneshot_mods = mods;
+}
+void clear_oneshot_mods(void) {
+    oneshot_mods = 0;
+}
+
+/* Keys */
+
+void add_key(uint8_t key) {
+    int empty = -1;
+    for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == key) {
+            return;
+        }
+        if (empty == -1 && report.keys[i] == 0) {
+            empty = i;
+        }
+    }
+    if (empty != -1) {
+        report.keys[empty] = key;
+    }
+}
+
+void del_key(uint8_t key) {
+    for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == key) {
+            report.keys[i] = 0;
+        }
+    }
+}
+
+void clear_keys(void) {
+    memset(report.keys, 0, sizeof(report.keys));
+}
+
+bool has_anykey(void) {
+    for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void clear_keyboard(void) {
+    clear_mods();
+    clear_weak_mods();
+    clear_keys();
+    send_keyboard_report();
+}
+
+void send_keyboard_report(void) {
+    report.mods = real_mods | weak_mods;
+    if (oneshot_mods) {
+        report.mods |= oneshot_mods;
+        if (has_anykey()) {
+            clear_oneshot_mods();
+        }
+    }
+    if (memcmp(&report, &last_report, sizeof(report)) != 0) {
+        last_report = report;
+        host_keyboard_send(&report);
+    }
+}
+
+/* Keycodes */
+
+static uint16_t extra_usage(uint8_t code) {
+    switch (code) {
+        case KC_SYSTEM_POWER:
+            return 0x81;
+        case KC_SYSTEM_SLEEP:
+            return 0x82;
+        case KC_SYSTEM_WAKE:
+            return 0x83;
+        case KC_AUDIO_MUTE:
+            return 0xE2;
+        case KC_AUDIO_VOL_UP:
+            return 0xE9;
+        case KC_AUDIO_VOL_DOWN:
+            return 0xEA;
+        case KC_MEDIA_NEXT_TRACK:
+            return 0xB5;
+        case KC_MEDIA_PREV_TRACK:
+            return 0xB6;
+        case KC_MEDIA_STOP:
+            return 0xB7;
+        case KC_MEDIA_PLAY_PAUSE:
+            return 0xCD;
+        case KC_BRIGHTNESS_UP:
+            return 0x6F;
+        case KC_BRIGHTNESS_DOWN:
+            return 0x70;
+        default:
+            return 0;
+    }
+}
+
+void register_code(uint8_t code) {
+    if (code == KC_NO) {
+        return;
+    } else if (IS_MODIFIER_KEYCODE(code)) {
+        add_mods(MOD_BIT(code));
+        send_keyboard_report();
+    } else if (code >= KC_SYSTEM_POWER && code <= KC_SYSTEM_WAKE) {
+        host_system_send(extra_usage(code));
+    } else if (code >= KC_AUDIO_MUTE && code <= KC_BRIGHTNESS_DOWN) {
+        host_consumer_send(extra_usage(code));
+    } else {
+        add_key(code);
+        send_keyboard_report();
+    }
+}
+
+void unregister_code(uint8_t code) {
+    if (code == KC_NO) {
+        return;
+    } else if (IS_MODIFIER_KEYCODE(code)) {
+        del_mods(MOD_BIT(code));
+        send_keyboard_report();
+    } else if (code >= KC_SYSTEM_POWER && code <= KC_SYSTEM_WAKE) {
+        host_system_send(0);
+    } else if (code >= KC_AUDIO_MUTE && code <= KC_BRIGHTNESS_DOWN) {
+        host_consumer_send(0);
+    } else {
+        del_key(code);
+        send_keyboard_report();
+    }
+}
+
+void tap_code_delay(uint8_t code, uint16_t delay) {
+    register_code(code);
+    wait_ms(delay);
+    unregister_code(code);
+}
+
+void tap_code(uint8_t code) {
+    tap_code_delay(code, code == KC_CAPS_LOCK ? 80 : TAP_CODE_DELAY);
+}
+
+static uint8_t keycode16_mods(uint16_t code) {
+    return MOD5_TO_MOD8(QK_MODS_GET_MODS(code));
+}
+
+void register_code16(uint16_t code) {
+    uint8_t mods = keycode16_mods(code);
+    if (IS_MODIFIER_KEYCODE(code & 0xFF) || (code & 0xFF) == KC_NO) {
+        register_mods(mods);
+    } else {
+        register_weak_mods(mods);
+    }
+    register_code(code & 0xFF);
+}
+
+void unregister_code16(uint16_t code) {
+    unregister_code(code & 0xFF);
+    uint8_t mods = keycode16_mods(code);
+    if (IS_MODIFIER_KEYCODE(code & 0xFF) || (code & 0xFF) == KC_NO) {
+        unregister_mods(mods);
+    } else {
+        unregister_weak_mods(mods);
+    }
+}
+
+void tap_code16_delay(uint16_t code, uint16_t delay) {
+    register_code16(code);
+    wait_ms(delay);
+    unregister_code16(code);
+}
+
+void tap_code16(uint16_t code) {
+    tap_code16_delay(code, code == KC_CAPS_LOCK ? 80 : TAP_CODE_DELAY);
+}
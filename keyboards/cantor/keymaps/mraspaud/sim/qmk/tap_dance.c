@@ -0,0 +1,176 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Tap dance, following QMK's process_tap_dance.c. A dance finishes when the
+// tapping term passes after its last tap or when another key interrupts it.
+
+#include "sim.h"
+
+#ifdef TAP_DANCE_ENABLE
+
+#    define TAP_DANCE_MAX_DANCES 32
+
+static tap_dance_state_t states[TAP_DANCE_MAX_DANCES];
+static int16_t           active_dance = -1;
+static uint32_t          last_tap;
+
+tap_dance_state_t *tap_dance_get_state(uint8_t tap_dance_idx) {
+    if (tap_dance_idx >= tap_dance_count() || tap_dance_idx >= TAP_DANCE_MAX_DANCES) {
+        return NULL;
+    }
+    return &states[tap_dance_idx];
+}
+
+/* ACTION_TAP_DANCE_DOUBLE */
+
+void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data) {
+    tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
+    if (state->count == 2) {
+        register_code16(pair->kc2);
+        state->finished = true;
+    }
+}
+
+void tap_dance_pair_finished(tap_dance_state_t *state, void *user_data) {
+    tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
+    register_code16(pair->kc1);
+}
+
+void tap_dance_pair_reset(tap_dance_state_t *state, void *user_data) {
+    tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
+    if (state->count == 1) {
+        wait_ms(TAP_CODE_DELAY);
+    }
+    unregister_code16(pair->kc1);
+    unregister_code16(pair->kc2);
+}
+
+/* Dance lifecycle */
+
+static uint16_t dance_term(uint16_t index) {
+#    ifdef TAPPING_TERM_PER_KEY
+    keyrecord_t record = {0};
+    return get_tapping_term(QK_TAP_DANCE | index, &record);
+#    else
+    (void)index;
+    return TAPPING_TERM;
+#    endif
+}
+
+static void dance_finished(uint16_t index) {
+    tap_dance_state_t  *state  = &states[index];
+    tap_dance_action_t *action = &tap_dance_actions[index];
+    if (state->finished) {
+        return;
+    }
+    state->finished = true;
+    add_weak_mods(state->weak_mods);
+    send_keyboard_report();
+    if (action->fn.on_dance_finished) {
+        action->fn.on_dance_finished(state, action->user_data);
+    }
+    del_weak_mods(state->weak_mods);
+    send_keyboard_report();
+}
+
+static void dance_reset(uint16_t index) {
+    tap_dance_state_t  *state  = &states[index];
+    tap_dance_action_t *action = &tap_dance_actions[index];
+    if (action->fn.on_reset) {
+        action->fn.on_reset(state, action->user_data);
+    }
+    memset(state, 0, sizeof(*state));
+    if (active_dance == index) {
+        active_dance = -1;
+    }
+}
+
+bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed || active_dance < 0) {
+        return false;
+    }
+    if (IS_QK_TAP_DANCE(keycode) && QK_TAP_DANCE_GET_INDEX(keycode) == active_dance) {
+        return false;
+    }
+    uint16_t           index = active_dance;
+    tap_dance_state_t *state = &states[index];
+    state->interrupted          = true;
+    state->interrupting_keycode = keycode;
+    dance_finished(index);
+    if (!state->pressed) {
+        dance_reset(index);
+    }
+    active_dance = -1;
+    return true;
+}
+
+bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_QK_TAP_DANCE(keycode)) {
+        return true;
+    }
+    uint16_t index = QK_TAP_DANCE_GET_INDEX(keycode);
+    if (index >= tap_dance_count() || index >= TAP_DANCE_MAX_DANCES) {
+        return false;
+    }
+    tap_dance_state_t  *state  = &states[index];
+    tap_dance_action_t *action = &tap_dance_actions[index];
+
+    if (record->event.pressed) {
+        state->pressed      = true;
+        state->count++;
+        state->weak_mods    = get_mods() | get_weak_mods();
+        state->oneshot_mods = get_oneshot_mods();
+        last_tap            = timer_read32();
+        active_dance        = index;
+        if (action->fn.on_each_tap) {
+            action->fn.on_each_tap(state, action->user_data);
+        }
+    } else {
+        state->pressed = false;
+        if (action->fn.on_each_release) {
+            action->fn.on_each_release(state, action->user_data);
+        }
+        if (state->finished) {
+            dance_reset(index);
+        }
+    }
+    return false;
+}
+
+void tap_dance_task(void) {
+    if (active_dance < 0) {
+        return;
+    }
+    uint16_t           index = active_dance;
+    tap_dance_state_t *state = &states[index];
+    if (!state->finished && timer_elapsed32(last_tap) > dance_term(index)) {
+        dance_finished(index);
+        if (!state->pressed) {
+            dance_reset(index);
+        }
+    }
+}
+
+uint64_t sim_tap_dance_deadline_us(void) {
+    if (active_dance < 0 || states[active_dance].finished) {
+        return SIM_NO_DEADLINE;
+    }
+    return ((uint64_t)last_tap + dance_term(active_dance) + 1) * 1000;
+}
+
+void sim_tap_dance_reset(void) {
+    memset(states, 0, sizeof(states));
+    active_dance = -1;
+}
+
+#else
+
+void tap_dance_task(void) {}
+
+uint64_t sim_tap_dance_deadline_us(void) {
+    return SIM_NO_DEADLINE;
+}
+
+void sim_tap_dance_reset(void) {}
+
+#endif
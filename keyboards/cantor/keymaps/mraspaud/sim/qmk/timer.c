@@ -0,0 +1,88 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Virtual clock. Everything in the simulator reads time from here, so a
+// replay is deterministic and independent of the host's speed.
+
+#include <stdarg.h>
+#include <time.h>
+
+#include "sim.h"
+
+static uint64_t now_us               = 0;
+static uint64_t last_matrix_activity = 0;
+static FILE    *console              = NULL;
+
+uint64_t sim_time_us(void) {
+    return now_us;
+}
+
+void sim_set_time_us(uint64_t t) {
+    if (t > now_us) {
+        now_us = t;
+    }
+}
+
+uint16_t timer_read(void) {
+    return (uint16_t)(now_us / 1000);
+}
+
+uint32_t timer_read32(void) {
+    return (uint32_t)(now_us / 1000);
+}
+
+uint16_t timer_elapsed(uint16_t last) {
+    return TIMER_DIFF_16(timer_read(), last);
+}
+
+uint32_t timer_elapsed32(uint32_t last) {
+    return TIMER_DIFF_32(timer_read32(), last);
+}
+
+void wait_ms(uint32_t ms) {
+    now_us += (uint64_t)ms * 1000;
+}
+
+void wait_us(uint32_t us) {
+    now_us += us;
+}
+
+void sim_activity_trigger(void) {
+    last_matrix_activity = now_us;
+}
+
+uint32_t last_matrix_activity_time(void) {
+    return (uint32_t)(last_matrix_activity / 1000);
+}
+
+uint32_t last_matrix_activity_elapsed(void) {
+    return timer_elapsed32(last_matrix_activity_time());
+}
+
+uint32_t last_input_activity_time(void) {
+    return last_matrix_activity_time();
+}
+
+uint32_t last_input_activity_elapsed(void) {
+    return last_matrix_activity_elapsed();
+}
+
+uint64_t sim_wall_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void sim_set_console(FILE *out) {
+    console = out;
+}
+
+void sim_printf(const char *fmt, ...) {
+    if (console == NULL) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(console, fmt, args);
+    va_end(args);
+}
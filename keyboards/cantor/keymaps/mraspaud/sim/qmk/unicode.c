@@ -0,0 +1,118 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Unicode input in Linux (IBus) mode and UNICODEMAP keycodes, following
+// QMK's unicode.c, unicodemap.c and process_unicode_common.c.
+
+#include "sim.h"
+
+#ifndef UNICODE_KEY_LNX
+#    define UNICODE_KEY_LNX LCTL(LSFT(KC_U))
+#endif
+
+static uint8_t saved_mods;
+
+void unicode_input_start(void) {
+    saved_mods = get_mods();
+    clear_mods();
+    clear_weak_mods();
+    tap_code16(UNICODE_KEY_LNX);
+    wait_ms(UNICODE_TYPE_DELAY);
+}
+
+void unicode_input_finish(void) {
+    tap_code(KC_SPC);
+    set_mods(saved_mods);
+}
+
+static const uint8_t hex_keycodes[16] = {
+    KC_0, KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_A, KC_B, KC_C, KC_D, KC_E, KC_F,
+};
+
+void register_hex32(uint32_t hex) {
+    bool first_digit = true;
+    for (int i = 7; i >= 0; i--) {
+        uint8_t digit = (hex >> (i * 4)) & 0xF;
+        if (digit != 0) {
+            first_digit = false;
+        }
+        // Skip leading zeros, but always send the last digit.
+        if (!first_digit || i == 0) {
+            tap_code(hex_keycodes[digit]);
+        }
+    }
+}
+
+void register_unicode(uint32_t code_point) {
+    unicode_input_start();
+    register_hex32(code_point);
+    unicode_input_finish();
+}
+
+static const char *decode_utf8(const char *str, int32_t *code_point) {
+    const uint8_t *s = (const uint8_t *)str;
+    if (s[0] < 0x80) {
+        *code_point = s[0];
+        return str + 1;
+    } else if ((s[0] & 0xE0) == 0xC0 && (s[1] & 0xC0) == 0x80) {
+        *code_point = ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+        return str + 2;
+    } else if ((s[0] & 0xF0) == 0xE0 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80) {
+        *code_point = ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        return str + 3;
+    } else if ((s[0] & 0xF8) == 0xF0 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80 && (s[3] & 0xC0) == 0x80) {
+        *code_point = ((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+        return str + 4;
+    }
+    *code_point = -1;
+    return str + 1;
+}
+
+void send_unicode_string(const char *str) {
+    if (str == NULL) {
+        return;
+    }
+    while (*str) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+        if (code_point >= 0) {
+            register_unicode(code_point);
+        }
+    }
+}
+
+#ifdef UNICODEMAP_ENABLE
+void register_unicodemap(uint16_t index) {
+    register_unicode(pgm_read_dword(unicode_map + index));
+}
+
+static uint16_t unicodemap_index(uint16_t keycode) {
+    if (IS_QK_UNICODEMAP_PAIR(keycode)) {
+        // Keycode is a pair: extract index based on Shift / Caps Lock state
+        uint16_t index;
+        uint8_t  mods = get_mods() | get_weak_mods() | get_oneshot_mods();
+        bool     shift = mods & MOD_MASK_SHIFT;
+        bool     caps  = host_keyboard_led_state().caps_lock;
+        if (shift ^ caps) {
+            index = QK_UNICODEMAP_PAIR_GET_SHIFTED_INDEX(keycode);
+        } else {
+            index = QK_UNICODEMAP_PAIR_GET_UNSHIFTED_INDEX(keycode);
+        }
+        return index;
+    }
+    return QK_UNICODEMAP_GET_INDEX(keycode);
+}
+#endif
+
+bool process_unicode_common(uint16_t keycode, keyrecord_t *record) {
+#ifdef UNICODEMAP_ENABLE
+    if (record->event.pressed && (IS_QK_UNICODEMAP(keycode) || IS_QK_UNICODEMAP_PAIR(keycode))) {
+        register_unicodemap(unicodemap_index(keycode));
+    }
+#endif
+    return true;
+}
+
+void sim_unicode_reset(void) {
+    saved_mods = 0;
+}
@@ -0,0 +1,929 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Layout scorer: counts how text corpora would be typed on one language
+// layer of keymap.c, and what swapping keys would change.
+//
+// The layout is read from keymaps[] by typing every key through the
+// simulator on the chosen layer: alone, with Shift held on the other hand,
+// under each momentary layer reachable from it, and the position combos
+// active there. Every pair of keys of the layer is typed as well, so that
+// what depends on the key before (the u after q, the second tap of a dance,
+// magic keys) is known too. Each distinct text so typed is a token, with
+// the keys it takes and the HID reports it sends; DI_TH's "th", Unicode
+// input and the rest are costed as the firmware sends them.
+//
+// Corpora are split into one range per worker process (one per core by
+// default) and cut into tokens, longest first, counting tokens and token
+// bigrams. Scores are then computed from those counts alone, so a layout
+// with keys swapped is rescored without reading the text again:
+//
+//     keystrokes/char   key presses per character typed, holds included
+//     reports/char      keyboard reports sent per character
+//     same finger       consecutive presses of different keys by one finger
+//     rolls in/out      consecutive presses by two fingers of one hand,
+//                       towards the index or away from it
+//     layer switches    tokens typed on another layer than the one before
+//
+//     ./score -l en corpus/en/*.txt
+//     ./score -l se -s 13:19 -s 3:16 sv.txt      # with two swaps
+//     ./score -l fr -a 10 fr.txt                 # the 10 best single swaps
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "features/finger_model.h"
+#include "features/pos_combos.h"
+#include "sim.h"
+#include "trace.h"
+
+#define MAX_TOKENS 512
+#define MAX_TEXT 16
+#define MAX_PRESSES 8
+#define MAX_STROKES 512
+#define MAX_FILES 256
+#define NO_KEY 0xFF
+#define HOLD_MS 300  // Past the tapping term: layer and Shift keys settle as holds.
+
+typedef struct {
+    uint8_t keys[POS_COMBO_MAX_KEYS];  // Pressed together when more than one.
+    uint8_t key_count;
+    uint8_t layer_key;  // Held for a momentary layer, or NO_KEY.
+    uint8_t shift_key;  // Held for Shift, or NO_KEY.
+    uint8_t layer;      // Layer the keys are typed on.
+} stroke_t;
+
+typedef struct {
+    uint8_t position;
+    bool    held;  // Typed under a momentary layer: not moved by swaps.
+} press_t;
+
+typedef struct {
+    char    text[MAX_TEXT];
+    uint8_t length;  // In bytes.
+    uint8_t chars;
+    uint8_t layer;
+    uint8_t press_count;
+    press_t presses[MAX_PRESSES];
+    uint8_t reports;
+} token_t;
+
+typedef struct {
+    uint64_t bytes;
+    uint64_t missing;  // Characters no token types.
+    uint64_t unigrams[MAX_TOKENS];
+    uint64_t bigrams[MAX_TOKENS * MAX_TOKENS];
+} counts_t;
+
+typedef struct {
+    uint16_t first;
+    uint16_t second;
+    uint64_t count;
+} bigram_t;
+
+typedef struct {
+    uint64_t chars;
+    uint64_t tokens;
+    uint64_t presses;
+    uint64_t reports;
+    uint64_t pairs;  // Consecutive presses.
+    uint64_t same_finger;
+    uint64_t rolls_in;
+    uint64_t rolls_out;
+    uint64_t layer_switches;
+} metrics_t;
+
+static uint8_t  language;
+static token_t  tokens[MAX_TOKENS];
+static uint16_t token_count = 0;
+static char     labels[SIM_LAYOUT_KEYS][MAX_TEXT];
+
+// Token + 1 typing a codepoint, and the chain of longer tokens starting with
+// it, longest first; 0 for none.
+static uint16_t single_token[0x10000];
+static uint16_t multi_head[0x10000];
+static uint16_t multi_next[MAX_TOKENS];
+
+/* Layout */
+
+// Fingers 0-9 from the left pinky, from keymap.c's finger_model; 4 and 5
+// are the thumbs.
+static uint8_t finger_of(uint8_t position) {
+    return finger_model[position].finger;
+}
+
+static bool left_hand(uint8_t position) {
+    return finger_is_left(finger_of(position));
+}
+
+// The keycode at `position` with `layer` on top of the language layer.
+static uint16_t keycode_on(uint8_t layer, uint8_t position) {
+    uint8_t row, col;
+    if (!sim_layout_to_matrix(position, &row, &col)) {
+        return KC_NO;
+    }
+    const uint8_t layers[] = {layer, language, 0};
+    for (size_t i = 0; i < ARRAY_SIZE(layers); i++) {
+        const uint16_t keycode = keycode_at_keymap_location(layers[i], row, col);
+        if (keycode != KC_TRNS) {
+            return keycode;
+        }
+    }
+    return KC_NO;
+}
+
+static int8_t momentary_layer(uint16_t keycode) {
+    if (IS_QK_LAYER_TAP(keycode)) {
+        return QK_LAYER_TAP_GET_LAYER(keycode);
+    }
+    if (IS_QK_MOMENTARY(keycode)) {
+        return QK_MOMENTARY_GET_LAYER(keycode);
+    }
+    return -1;
+}
+
+static bool is_shift(uint16_t keycode) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        return QK_MOD_TAP_GET_MODS(keycode) & MOD_LSFT;
+    }
+    return keycode == KC_LSFT || keycode == KC_RSFT;
+}
+
+// A key of the language layer passing `test`, on the other hand from
+// `position` if there is one, and never `position` or `taken` itself.
+static uint8_t find_key(bool (*test)(uint16_t keycode, void *arg), void *arg, uint8_t position, uint8_t taken) {
+    uint8_t found = NO_KEY;
+    for (uint8_t p = 0; p < SIM_LAYOUT_KEYS; p++) {
+        if (p == position || p == taken || !test(keycode_on(language, p), arg)) {
+            continue;
+        }
+        if (left_hand(p) != left_hand(position)) {
+            return p;
+        }
+        if (found == NO_KEY) {
+            found = p;
+        }
+    }
+    return found;
+}
+
+static bool shift_test(uint16_t keycode, void *arg) {
+    (void)arg;
+    return is_shift(keycode);
+}
+
+static bool layer_test(uint16_t keycode, void *arg) {
+    return momentary_layer(keycode) == *(uint8_t *)arg;
+}
+
+/* Typing through the simulator */
+
+typedef struct {
+    FILE              *text;
+    sim_text_decoder_t decoder;
+    unsigned           reports;
+} capture_t;
+
+static void capture_report(const sim_report_t *report, void *arg) {
+    capture_t *capture = arg;
+    if (report->type == SIM_REPORT_KEYBOARD) {
+        capture->reports++;
+    }
+    sim_text_decode(&capture->decoder, report, capture->text);
+}
+
+static void add_event(trace_t *trace, uint32_t time_ms, uint8_t position, bool pressed) {
+    trace_event_t *event = &trace->events[trace->count++];
+    *event               = (trace_event_t){.time_ms = time_ms, .pressed = pressed};
+    sim_layout_to_matrix(position, &event->row, &event->col);
+}
+
+// A key name printed by the decoder, as "<esc>" or "<C-0x06>".
+static bool is_key_name(const char *text) {
+    static const char name_chars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789- ";
+    const size_t      length       = strspn(text + 1, name_chars);
+    return text[0] == '<' && length > 0 && text[1 + length] == '>';
+}
+
+// Applies the backspaces and tabs of the decoded text. Returns false if keys
+// other than text were sent.
+static bool clean_text(char *text) {
+    char *out = text;
+    for (const char *in = text; *in;) {
+        if (strncmp(in, "<bspc>", 6) == 0) {
+            while (out > text && (*--out & 0xC0) == 0x80) {
+            }
+            in += 6;
+        } else if (strncmp(in, "<tab>", 5) == 0) {
+            *out++ = '\t';
+            in += 5;
+        } else if (is_key_name(in)) {
+            return false;
+        } else {
+            *out++ = *in++;
+        }
+    }
+    *out = '\0';
+    return true;
+}
+
+// Types the strokes one after the other on a freshly booted keyboard.
+static bool type_strokes(const stroke_t *strokes, uint8_t count, char *text, size_t size, unsigned *reports) {
+    trace_event_t events[64];
+    trace_t       trace = {.events = events, .capacity = ARRAY_SIZE(events)};
+    uint32_t      time  = 100;
+    for (uint8_t s = 0; s < count; s++) {
+        const stroke_t *stroke = &strokes[s];
+        if (stroke->shift_key != NO_KEY) {
+            add_event(&trace, time, stroke->shift_key, true);
+        }
+        if (stroke->layer_key != NO_KEY) {
+            add_event(&trace, time, stroke->layer_key, true);
+        }
+        if (stroke->shift_key != NO_KEY || stroke->layer_key != NO_KEY) {
+            time += HOLD_MS;
+        }
+        for (uint8_t k = 0; k < stroke->key_count; k++) {
+            add_event(&trace, time, stroke->keys[k], true);
+        }
+        time += 30;
+        for (uint8_t k = 0; k < stroke->key_count; k++) {
+            add_event(&trace, time, stroke->keys[k], false);
+        }
+        time += 20;
+        if (stroke->layer_key != NO_KEY) {
+            add_event(&trace, time, stroke->layer_key, false);
+        }
+        if (stroke->shift_key != NO_KEY) {
+            add_event(&trace, time, stroke->shift_key, false);
+        }
+        time += 100;
+    }
+
+    char     *buffer = NULL;
+    size_t    length = 0;
+    capture_t capture = {.text = open_memstream(&buffer, &length)};
+    const uint64_t base = trace_start();
+    layer_move(language);
+    sim_set_report_sink(capture_report, &capture);
+    trace_replay(&trace, base, NULL, NULL);
+    sim_set_report_sink(NULL, NULL);
+    fclose(capture.text);
+
+    const bool ok = clean_text(buffer) && strlen(buffer) < size;
+    if (ok) {
+        strcpy(text, buffer);
+    }
+    free(buffer);
+    *reports = capture.reports;
+    return ok;
+}
+
+static uint8_t press_count_of(const stroke_t *strokes, uint8_t count) {
+    uint8_t presses = 0;
+    for (uint8_t s = 0; s < count; s++) {
+        presses += strokes[s].key_count + (strokes[s].shift_key != NO_KEY) + (strokes[s].layer_key != NO_KEY);
+    }
+    return presses;
+}
+
+static uint8_t utf8_length(uint8_t lead) {
+    return lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+}
+
+// Adds the token typing `text`, or makes it cheaper. Returns false when the
+// table is full.
+static bool add_token(const char *text, const stroke_t *strokes, uint8_t count, unsigned reports) {
+    const uint8_t presses = press_count_of(strokes, count);
+    if (text[0] == '\0' || presses > MAX_PRESSES) {
+        return true;
+    }
+    token_t *token = NULL;
+    for (uint16_t t = 0; t < token_count; t++) {
+        if (strcmp(tokens[t].text, text) == 0) {
+            token = &tokens[t];
+            break;
+        }
+    }
+    if (token == NULL) {
+        if (token_count == MAX_TOKENS) {
+            return false;
+        }
+        token = &tokens[token_count++];
+    } else if (token->press_count < presses || (token->press_count == presses && token->reports <= reports)) {
+        return true;
+    }
+    *token = (token_t){.length = strlen(text), .layer = strokes[count - 1].layer, .press_count = 0, .reports = reports};
+    strcpy(token->text, text);
+    for (const char *c = text; *c; c += utf8_length(*c)) {
+        token->chars++;
+    }
+    for (uint8_t s = 0; s < count; s++) {
+        const stroke_t *stroke = &strokes[s];
+        const bool      held   = stroke->layer != language;
+        if (stroke->shift_key != NO_KEY) {
+            token->presses[token->press_count++] = (press_t){stroke->shift_key, false};
+        }
+        if (stroke->layer_key != NO_KEY) {
+            token->presses[token->press_count++] = (press_t){stroke->layer_key, false};
+        }
+        for (uint8_t k = 0; k < stroke->key_count; k++) {
+            token->presses[token->press_count++] = (press_t){stroke->keys[k], held};
+        }
+    }
+    return true;
+}
+
+static stroke_t single(uint8_t position, uint8_t layer, uint8_t layer_key) {
+    return (stroke_t){.keys = {position}, .key_count = 1, .layer_key = layer_key, .shift_key = NO_KEY, .layer = layer};
+}
+
+static stroke_t shifted(stroke_t stroke) {
+    stroke.shift_key = find_key(shift_test, NULL, stroke.keys[0], stroke.layer_key);
+    return stroke;
+}
+
+static uint16_t list_strokes(stroke_t *strokes) {
+    uint16_t count = 0;
+    for (uint8_t p = 0; p < SIM_LAYOUT_KEYS; p++) {
+        strokes[count++] = single(p, language, NO_KEY);
+        strokes[count++] = shifted(single(p, language, NO_KEY));
+    }
+    for (uint8_t layer = 0; layer < keymap_layer_count(); layer++) {
+        for (uint8_t p = 0; p < SIM_LAYOUT_KEYS && layer != language; p++) {
+            const uint8_t layer_key = find_key(layer_test, &layer, p, NO_KEY);
+            uint8_t       row, col;
+            if (layer_key == NO_KEY || !sim_layout_to_matrix(p, &row, &col) || keycode_at_keymap_location(layer, row, col) == KC_TRNS) {
+                continue;
+            }
+            strokes[count++] = single(p, layer, layer_key);
+            strokes[count++] = shifted(single(p, layer, layer_key));
+        }
+    }
+    for (uint8_t i = 0; i < NUM_POS_COMBOS && count < MAX_STROKES; i++) {
+        pos_combo_t combo;
+        memcpy_P(&combo, &pos_combos[i], sizeof(combo));
+        if (!(combo.layers & ((layer_state_t)1 << language))) {
+            continue;
+        }
+        stroke_t stroke = {.layer_key = NO_KEY, .shift_key = NO_KEY, .layer = language};
+        for (uint8_t k = 0; k < POS_COMBO_MAX_KEYS && combo.keys[k] != 0; k++) {
+            stroke.keys[stroke.key_count++] = combo.keys[k] - 1;
+        }
+        strokes[count++] = stroke;
+    }
+    return count;
+}
+
+// Types every stroke alone, then every pair of keys of the language layer,
+// keeping pairs whose text is not that of their keys one after the other.
+static bool build_tokens(void) {
+    static stroke_t strokes[MAX_STROKES];
+    static char     texts[MAX_STROKES][MAX_TEXT];
+    const uint16_t  count = list_strokes(strokes);
+    unsigned        reports;
+    for (uint16_t s = 0; s < count; s++) {
+        if (!type_strokes(&strokes[s], 1, texts[s], MAX_TEXT, &reports)) {
+            texts[s][0] = '\0';
+            continue;
+        }
+        if (!add_token(texts[s], &strokes[s], 1, reports)) {
+            return false;
+        }
+        if (s < 2 * SIM_LAYOUT_KEYS && s % 2 == 0) {
+            strcpy(labels[s / 2], texts[s][0] ? texts[s] : "?");
+        }
+    }
+    for (uint16_t a = 0; a < 2 * SIM_LAYOUT_KEYS; a++) {
+        for (uint16_t b = 0; b < 2 * SIM_LAYOUT_KEYS && texts[a][0]; b++) {
+            char           text[MAX_TEXT], apart[2 * MAX_TEXT];
+            const stroke_t pair[2] = {strokes[a], strokes[b]};
+            if (!texts[b][0] || !type_strokes(pair, 2, text, sizeof(text), &reports)) {
+                continue;
+            }
+            strcat(strcpy(apart, texts[a]), texts[b]);
+            if (strcmp(text, apart) != 0 && !add_token(text, pair, 2, reports)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Counting */
+
+static uint8_t utf8_decode(const uint8_t *p, const uint8_t *end, uint32_t *cp) {
+    const uint8_t length = utf8_length(p[0]);
+    if (p + length > end || (p[0] & 0xC0) == 0x80) {
+        *cp = 0xFFFD;
+        return 1;
+    }
+    static const uint8_t lead_bits[5] = {0, 0x7F, 0x1F, 0x0F, 0x07};
+    uint32_t             value        = p[0] & lead_bits[length];
+    for (uint8_t i = 1; i < length; i++) {
+        value = value << 6 | (p[i] & 0x3F);
+    }
+    *cp = value;
+    return length;
+}
+
+static void index_tokens(void) {
+    // Longest first, so that the first match in a chain is the longest.
+    for (uint8_t length = MAX_TEXT - 1; length > 0; length--) {
+        for (uint16_t t = 0; t < token_count; t++) {
+            uint32_t cp;
+            if (tokens[t].length != length || utf8_decode((const uint8_t *)tokens[t].text, (const uint8_t *)tokens[t].text + length, &cp) == 0 || cp >= 0x10000) {
+                continue;
+            }
+            if (tokens[t].chars == 1) {
+                single_token[cp] = t + 1;
+                continue;
+            }
+            uint16_t *link = &multi_head[cp];
+            while (*link) {
+                link = &multi_next[*link - 1];
+            }
+            *link = t + 1;
+        }
+    }
+}
+
+static void count_range(const uint8_t *p, const uint8_t *end, counts_t *counts) {
+    int prev = -1;
+    counts->bytes += end - p;
+    while (p < end) {
+        uint32_t cp;
+        uint8_t  length;
+        if (*p < 0x80) {
+            cp     = *p;
+            length = 1;
+        } else {
+            length = utf8_decode(p, end, &cp);
+        }
+        if (cp == '\r') {
+            p += length;
+            continue;
+        }
+        int token = -1;
+        if (cp < 0x10000) {
+            for (uint16_t t = multi_head[cp]; t; t = multi_next[t - 1]) {
+                if (end - p >= tokens[t - 1].length && memcmp(p, tokens[t - 1].text, tokens[t - 1].length) == 0) {
+                    token = t - 1;
+                    break;
+                }
+            }
+            if (token < 0) {
+                token = single_token[cp] - 1;
+            }
+        }
+        if (token < 0) {
+            counts->missing++;
+            prev = -1;
+            p += length;
+            continue;
+        }
+        counts->unigrams[token]++;
+        if (prev >= 0) {
+            counts->bigrams[prev * MAX_TOKENS + token]++;
+        }
+        prev = token;
+        p += tokens[token].length;
+    }
+}
+
+typedef struct {
+    const uint8_t *data;
+    size_t         size;
+} corpus_t;
+
+// Start of the w-th of `workers` ranges of `corpus`, moved past the next
+// space or newline so that no character or word is cut.
+static size_t range_start(const corpus_t *corpus, unsigned w, unsigned workers) {
+    if (w == 0) {
+        return 0;
+    }
+    size_t start = corpus->size * w / workers;
+    while (start < corpus->size && corpus->data[start - 1] != ' ' && corpus->data[start - 1] != '\n') {
+        start++;
+    }
+    return start;
+}
+
+static bool write_all(int fd, const void *data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written <= 0) {
+            return false;
+        }
+        data = (const char *)data + written;
+        size -= written;
+    }
+    return true;
+}
+
+static bool read_all(int fd, void *data, size_t size) {
+    while (size > 0) {
+        ssize_t got = read(fd, data, size);
+        if (got <= 0) {
+            return false;
+        }
+        data = (char *)data + got;
+        size -= got;
+    }
+    return true;
+}
+
+// Counts the corpora over `workers` forked processes, worker w taking the
+// w-th range of every corpus, and sums their counts into `total`.
+static bool count_corpora(const corpus_t *corpora, int count, unsigned workers, counts_t *total) {
+    int       fds[workers];
+    pid_t     pids[workers];
+    counts_t *counts = malloc(sizeof(counts_t));
+    if (counts == NULL) {
+        return false;
+    }
+    for (unsigned w = 0; w < workers; w++) {
+        int pipe_fds[2];
+        if (pipe(pipe_fds) != 0) {
+            perror("pipe");
+            return false;
+        }
+        pids[w] = fork();
+        if (pids[w] < 0) {
+            perror("fork");
+            return false;
+        }
+        if (pids[w] == 0) {
+            close(pipe_fds[0]);
+            memset(counts, 0, sizeof(*counts));
+            for (int c = 0; c < count; c++) {
+                const size_t start = range_start(&corpora[c], w, workers);
+                const size_t end   = range_start(&corpora[c], w + 1, workers);
+                count_range(corpora[c].data + start, corpora[c].data + (w + 1 == workers ? corpora[c].size : end), counts);
+            }
+            _exit(write_all(pipe_fds[1], counts, sizeof(*counts)) ? 0 : 1);
+        }
+        close(pipe_fds[1]);
+        fds[w] = pipe_fds[0];
+    }
+    bool ok = true;
+    memset(total, 0, sizeof(*total));
+    for (unsigned w = 0; w < workers; w++) {
+        if (ok && read_all(fds[w], counts, sizeof(*counts))) {
+            total->bytes += counts->bytes;
+            total->missing += counts->missing;
+            for (size_t i = 0; i < MAX_TOKENS; i++) {
+                total->unigrams[i] += counts->unigrams[i];
+            }
+            for (size_t i = 0; i < MAX_TOKENS * MAX_TOKENS; i++) {
+                total->bigrams[i] += counts->bigrams[i];
+            }
+        } else {
+            ok = false;
+        }
+        close(fds[w]);
+        int status;
+        waitpid(pids[w], &status, 0);
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    free(counts);
+    return ok;
+}
+
+/* Scoring */
+
+static uint8_t moved(press_t press, const uint8_t *layout) {
+    return press.held ? press.position : layout[press.position];
+}
+
+static void score_pair(uint8_t a, uint8_t b, uint64_t count, metrics_t *metrics) {
+    metrics->pairs += count;
+    const uint8_t fa = finger_of(a), fb = finger_of(b);
+    if (a == b || (fa == 4 || fa == 5) || (fb == 4 || fb == 5) || left_hand(a) != left_hand(b)) {
+        return;
+    }
+    if (fa == fb) {
+        metrics->same_finger += count;
+    } else if ((fb > fa) == left_hand(a)) {
+        metrics->rolls_in += count;
+    } else {
+        metrics->rolls_out += count;
+    }
+}
+
+static bool same_finger(uint16_t first, uint16_t second, const uint8_t *layout) {
+    const uint8_t a = moved(tokens[first].presses[tokens[first].press_count - 1], layout);
+    const uint8_t b = moved(tokens[second].presses[0], layout);
+    return a != b && finger_of(a) == finger_of(b) && finger_of(a) != 4 && finger_of(a) != 5;
+}
+
+// Scores the counts with the keys of the language layer moved as in
+// `layout`: the key at position p goes to layout[p].
+static void score(const counts_t *counts, const bigram_t *bigrams, size_t bigram_count, const uint8_t *layout, metrics_t *metrics) {
+    memset(metrics, 0, sizeof(*metrics));
+    for (uint16_t t = 0; t < token_count; t++) {
+        const uint64_t count = counts->unigrams[t];
+        const token_t *token = &tokens[t];
+        if (count == 0) {
+            continue;
+        }
+        metrics->tokens += count;
+        metrics->chars += count * token->chars;
+        metrics->presses += count * token->press_count;
+        metrics->reports += count * token->reports;
+        for (uint8_t i = 1; i < token->press_count; i++) {
+            score_pair(moved(token->presses[i - 1], layout), moved(token->presses[i], layout), count, metrics);
+        }
+    }
+    for (size_t i = 0; i < bigram_count; i++) {
+        const token_t *first  = &tokens[bigrams[i].first];
+        const token_t *second = &tokens[bigrams[i].second];
+        score_pair(moved(first->presses[first->press_count - 1], layout), moved(second->presses[0], layout), bigrams[i].count, metrics);
+        if (first->layer != second->layer) {
+            metrics->layer_switches += bigrams[i].count;
+        }
+    }
+}
+
+/* Output */
+
+static double percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * part / whole : 0;
+}
+
+static double ratio(uint64_t part, uint64_t whole) {
+    return whole ? (double)part / whole : 0;
+}
+
+// `text` with whitespace made visible.
+static const char *visible(const char *text) {
+    static char out[4 * 2 * MAX_TEXT];
+    out[0] = '\0';
+    for (; *text; text++) {
+        switch (*text) {
+            case ' ':
+                strcat(out, "␣");
+                break;
+            case '\n':
+                strcat(out, "⏎");
+                break;
+            case '\t':
+                strcat(out, "⇥");
+                break;
+            default:
+                strncat(out, text, 1);
+                break;
+        }
+    }
+    return out;
+}
+
+static void print_metrics(const char *const *names, const metrics_t *metrics, int count) {
+    printf("  %-18s", "");
+    for (int i = 0; i < count; i++) {
+        printf(" %12s", names[i]);
+    }
+    printf("\n  %-18s", "keystrokes/char");
+    for (int i = 0; i < count; i++) {
+        printf(" %12.3f", ratio(metrics[i].presses, metrics[i].chars));
+    }
+    printf("\n  %-18s", "reports/char");
+    for (int i = 0; i < count; i++) {
+        printf(" %12.3f", ratio(metrics[i].reports, metrics[i].chars));
+    }
+    printf("\n  %-18s", "same finger");
+    for (int i = 0; i < count; i++) {
+        printf(" %11.2f%%", percent(metrics[i].same_finger, metrics[i].pairs));
+    }
+    printf("\n  %-18s", "rolls in");
+    for (int i = 0; i < count; i++) {
+        printf(" %11.2f%%", percent(metrics[i].rolls_in, metrics[i].pairs));
+    }
+    printf("\n  %-18s", "rolls out");
+    for (int i = 0; i < count; i++) {
+        printf(" %11.2f%%", percent(metrics[i].rolls_out, metrics[i].pairs));
+    }
+    printf("\n  %-18s", "layer switches");
+    for (int i = 0; i < count; i++) {
+        printf(" %11.2f%%", percent(metrics[i].layer_switches, metrics[i].tokens));
+    }
+    printf("\n");
+}
+
+static int by_count(const void *a, const void *b) {
+    const bigram_t *x = a, *y = b;
+    return x->count < y->count ? 1 : x->count > y->count ? -1 : 0;
+}
+
+static void print_same_finger(const bigram_t *bigrams, size_t count, const uint8_t *layout, uint64_t pairs) {
+    printf("\n  most frequent same finger bigrams:");
+    unsigned shown = 0;
+    for (size_t i = 0; i < count && shown < 12; i++) {
+        if (same_finger(bigrams[i].first, bigrams[i].second, layout)) {
+            char text[2 * MAX_TEXT];
+            snprintf(text, sizeof(text), "%s%s", tokens[bigrams[i].first].text, tokens[bigrams[i].second].text);
+            printf("%s %s %.2f%%", shown % 4 ? "," : "\n   ", visible(text), percent(bigrams[i].count, pairs));
+            shown++;
+        }
+    }
+    printf("\n");
+}
+
+typedef struct {
+    uint8_t   a;
+    uint8_t   b;
+    metrics_t metrics;
+} swap_t;
+
+static int by_same_finger(const void *x, const void *y) {
+    const swap_t *a = x, *b = y;
+    const double  fa = percent(a->metrics.same_finger, a->metrics.pairs), fb = percent(b->metrics.same_finger, b->metrics.pairs);
+    return fa < fb ? -1 : fa > fb ? 1 : 0;
+}
+
+// Tries every swap of two keys of the finger rows, best first.
+static void print_best_swaps(const counts_t *counts, const bigram_t *bigrams, size_t count, const uint8_t *layout, const metrics_t *current, unsigned shown) {
+    static swap_t swaps[36 * 35 / 2];
+    size_t        swap_count = 0;
+    for (uint8_t a = 0; a < 36; a++) {
+        for (uint8_t b = a + 1; b < 36; b++) {
+            uint8_t trial[SIM_LAYOUT_KEYS];
+            memcpy(trial, layout, sizeof(trial));
+            for (uint8_t p = 0; p < SIM_LAYOUT_KEYS; p++) {
+                trial[p] = layout[p] == a ? b : layout[p] == b ? a : layout[p];
+            }
+            swaps[swap_count] = (swap_t){.a = a, .b = b};
+            score(counts, bigrams, count, trial, &swaps[swap_count].metrics);
+            swap_count++;
+        }
+    }
+    qsort(swaps, swap_count, sizeof(*swaps), by_same_finger);
+    const double same = percent(current->same_finger, current->pairs);
+    const double in   = percent(current->rolls_in, current->pairs);
+    printf("\n  best swaps by same finger bigrams:\n");
+    for (size_t i = 0; i < swap_count && i < shown; i++) {
+        const metrics_t *m = &swaps[i].metrics;
+        char             option[16], keys[2 * MAX_TEXT + 4];
+        snprintf(option, sizeof(option), "-s %u:%u", swaps[i].a, swaps[i].b);
+        snprintf(keys, sizeof(keys), "%s", visible(labels[swaps[i].a]));
+        snprintf(keys + strlen(keys), sizeof(keys) - strlen(keys), " %s", visible(labels[swaps[i].b]));
+        printf("    %-9s %-8s same finger %.2f%% (%+.2f), rolls in %.2f%% (%+.2f)\n", option, keys, percent(m->same_finger, m->pairs), percent(m->same_finger, m->pairs) - same, percent(m->rolls_in, m->pairs),
+               percent(m->rolls_in, m->pairs) - in);
+    }
+}
+
+/* Setup */
+
+static bool map_corpus(const char *path, corpus_t *corpus) {
+    const int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(path);
+        return false;
+    }
+    corpus->size = st.st_size;
+    corpus->data = NULL;
+    if (corpus->size > 0) {
+        void *data = mmap(NULL, corpus->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            perror(path);
+            close(fd);
+            return false;
+        }
+        madvise(data, corpus->size, MADV_SEQUENTIAL);
+        corpus->data = data;
+    }
+    close(fd);
+    return true;
+}
+
+static void usage(FILE *out) {
+    fprintf(out,
+            "usage: score -l LAYER [options] corpus ...\n"
+            "Scores a language layer of keymap.c against UTF-8 text corpora.\n"
+            "  -l, --layer NAME     layer to type on: en, se, fr...\n"
+            "  -s, --swap A:B       swap the keys at layout indices A and B (repeatable)\n"
+            "  -a, --all-swaps N    list the N single swaps with the fewest same finger bigrams\n"
+            "  -j, --jobs N         worker processes (default: one per core)\n");
+}
+
+int main(int argc, char **argv) {
+    static const struct option options[] = {
+        {"layer", required_argument, NULL, 'l'},
+        {"swap", required_argument, NULL, 's'},
+        {"all-swaps", required_argument, NULL, 'a'},
+        {"jobs", required_argument, NULL, 'j'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int         layer      = -1;
+    const char *layer_name = NULL;
+    uint8_t     layout[SIM_LAYOUT_KEYS];
+    bool        swapped = false;
+    unsigned    best    = 0;
+    long        jobs    = sysconf(_SC_NPROCESSORS_ONLN);
+    int         opt;
+    for (uint8_t p = 0; p < SIM_LAYOUT_KEYS; p++) {
+        layout[p] = p;
+    }
+    while ((opt = getopt_long(argc, argv, "l:s:a:j:h", options, NULL)) != -1) {
+        switch (opt) {
+            case 'l':
+                layer      = sim_layer_named(optarg);
+                layer_name = optarg;
+                if (layer < 0) {
+                    fprintf(stderr, "no layer named '%s'\n", optarg);
+                    return 2;
+                }
+                break;
+            case 's': {
+                unsigned a, b;
+                if (sscanf(optarg, "%u:%u", &a, &b) != 2 || a >= SIM_LAYOUT_KEYS || b >= SIM_LAYOUT_KEYS) {
+                    fprintf(stderr, "expected A:B layout indices, got '%s'\n", optarg);
+                    return 2;
+                }
+                for (uint8_t p = 0; p < SIM_LAYOUT_KEYS; p++) {
+                    layout[p] = layout[p] == a ? b : layout[p] == b ? a : layout[p];
+                }
+                swapped = true;
+                break;
+            }
+            case 'a':
+                best = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                jobs = strtol(optarg, NULL, 10);
+                break;
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+    if (jobs < 1) {
+        jobs = 1;
+    }
+    const int corpus_count = argc - optind;
+    if (layer < 0 || corpus_count == 0 || corpus_count > MAX_FILES) {
+        usage(stderr);
+        return 2;
+    }
+    language = layer;
+
+    if (!build_tokens()) {
+        fprintf(stderr, "more than %u distinct texts typed on the layer\n", MAX_TOKENS);
+        return 1;
+    }
+    index_tokens();
+
+    static corpus_t corpora[MAX_FILES];
+    for (int c = 0; c < corpus_count; c++) {
+        if (!map_corpus(argv[optind + c], &corpora[c])) {
+            return 1;
+        }
+    }
+    counts_t *counts = malloc(sizeof(counts_t));
+    const uint64_t start = sim_wall_ns();
+    if (counts == NULL || !count_corpora(corpora, corpus_count, jobs, counts)) {
+        fprintf(stderr, "counting failed\n");
+        return 1;
+    }
+    const double seconds = (sim_wall_ns() - start) / 1e9;
+
+    static bigram_t bigrams[MAX_TOKENS * MAX_TOKENS];
+    size_t          bigram_count = 0;
+    for (uint16_t a = 0; a < token_count; a++) {
+        for (uint16_t b = 0; b < token_count; b++) {
+            if (counts->bigrams[a * MAX_TOKENS + b]) {
+                bigrams[bigram_count++] = (bigram_t){a, b, counts->bigrams[a * MAX_TOKENS + b]};
+            }
+        }
+    }
+    qsort(bigrams, bigram_count, sizeof(*bigrams), by_count);
+
+    uint8_t identity[SIM_LAYOUT_KEYS];
+    for (uint8_t p = 0; p < SIM_LAYOUT_KEYS; p++) {
+        identity[p] = p;
+    }
+    metrics_t metrics[2];
+    score(counts, bigrams, bigram_count, identity, &metrics[0]);
+    score(counts, bigrams, bigram_count, layout, &metrics[1]);
+
+    printf("%s: %.1f MB in %.2f s (%ld workers), %llu characters, %.3f%% not typeable, %u tokens\n\n", layer_name, counts->bytes / 1e6, seconds, jobs, (unsigned long long)metrics[0].chars,
+           percent(counts->missing, metrics[0].chars + counts->missing), token_count);
+    static const char *const names[] = {"keymap", "swapped"};
+    print_metrics(names, metrics, swapped ? 2 : 1);
+    print_same_finger(bigrams, bigram_count, layout, metrics[swapped].pairs);
+    if (best > 0) {
+        print_best_swaps(counts, bigrams, bigram_count, layout, &metrics[swapped], best);
+    }
+    free(counts);
+    return 0;
+}
@@ -0,0 +1,153 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Trace replayer: feeds a recorded sequence of key presses through keymap.c
+// and prints the HID reports the host would receive. See trace.h for the
+// trace format.
+
+#include <getopt.h>
+#include <stdlib.h>
+
+#include "sim.h"
+#include "trace.h"
+
+typedef struct {
+    FILE              *out;
+    bool               text;
+    uint64_t           base_us;
+    sim_text_decoder_t decoder;
+} output_t;
+
+static void usage(FILE *out) {
+    fprintf(out,
+            "usage: sim [options] [trace ...]\n"
+            "Replays key traces (stdin when none is given) through keymap.c.\n"
+            "  -t, --text          print the decoded text instead of reports\n"
+            "  -s, --stats         print per-event processing cost to stderr\n"
+            "  -r, --repeat N      replay each trace N times (implies no output after the first)\n"
+            "  -c, --console       print dprintf/uprintf output to stderr\n"
+            "      --scan-hz HZ    also run the keyboard task at this scan rate\n"
+            "      --usb-interval-us US\n"
+            "                      minimum spacing between reports (default 1000)\n");
+}
+
+static void print_report(const sim_report_t *report, void *arg) {
+    output_t *output = arg;
+    if (output->out == NULL) {
+        return;
+    }
+    if (output->text) {
+        sim_text_decode(&output->decoder, report, output->out);
+        return;
+    }
+    fprintf(output->out, "%9.3f ", (double)(report->time_us - output->base_us) / 1000.0);
+    switch (report->type) {
+        case SIM_REPORT_KEYBOARD:
+            fprintf(output->out, "kbd %02X", report->keyboard.mods);
+            for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                fprintf(output->out, " %02X", report->keyboard.keys[i]);
+            }
+            fputc('\n', output->out);
+            break;
+        case SIM_REPORT_SYSTEM:
+            fprintf(output->out, "sys %04X\n", report->usage);
+            break;
+        case SIM_REPORT_CONSUMER:
+            fprintf(output->out, "cons %04X\n", report->usage);
+            break;
+        case SIM_REPORT_BOOTLOADER:
+            fprintf(output->out, "boot\n");
+            break;
+        case SIM_REPORT_REBOOT:
+            fprintf(output->out, "reboot\n");
+            break;
+    }
+}
+
+static void replay(const trace_t *trace, output_t *output) {
+    output->base_us = trace_start();
+    memset(&output->decoder, 0, sizeof(output->decoder));
+    sim_set_report_sink(print_report, output);
+    trace_replay(trace, output->base_us, NULL, NULL);
+    sim_set_report_sink(NULL, NULL);
+}
+
+int main(int argc, char **argv) {
+    static const struct option options[] = {
+        {"text", no_argument, NULL, 't'},
+        {"stats", no_argument, NULL, 's'},
+        {"repeat", required_argument, NULL, 'r'},
+        {"console", no_argument, NULL, 'c'},
+        {"scan-hz", required_argument, NULL, 'S'},
+        {"usb-interval-us", required_argument, NULL, 'U'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    output_t output  = {.out = stdout};
+    unsigned repeats = 1;
+    int      opt;
+    while ((opt = getopt_long(argc, argv, "tsr:ch", options, NULL)) != -1) {
+        switch (opt) {
+            case 't':
+                output.text = true;
+                break;
+            case 's':
+                sim_stats_enabled = true;
+                break;
+            case 'r':
+                repeats = strtoul(optarg, NULL, 10);
+                break;
+            case 'c':
+                sim_set_console(stderr);
+                break;
+            case 'S':
+                sim_set_scan_rate(strtoul(optarg, NULL, 10));
+                break;
+            case 'U':
+                sim_set_usb_interval_us(strtoul(optarg, NULL, 10));
+                break;
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+
+    trace_t trace = {0};
+    if (!trace_load_files(&trace, &argv[optind], argc - optind)) {
+        return 1;
+    }
+
+    uint64_t events  = 0;
+    uint64_t calls   = 0;
+    uint64_t user_ns = 0;
+    uint64_t reads   = 0;
+    uint64_t wall_ns = 0;
+    for (unsigned run = 0; run < repeats; run++) {
+        const uint64_t start = sim_wall_ns();
+        replay(&trace, &output);
+        wall_ns += sim_wall_ns() - start;
+        events += sim_stats.events;
+        calls += sim_stats.user_calls;
+        user_ns += sim_stats.user_ns;
+        reads += sim_stats.keymap_reads;
+        if (output.text && output.out != NULL) {
+            fputc('\n', output.out);
+        }
+        output.out = NULL;
+    }
+
+    if (sim_stats_enabled && events > 0) {
+        fprintf(stderr, "events: %llu\n", (unsigned long long)events);
+        fprintf(stderr, "events/s: %.0f\n", (double)events * 1e9 / (double)wall_ns);
+        fprintf(stderr, "ns/event: %.1f\n", (double)wall_ns / (double)events);
+        if (calls > 0) {
+            fprintf(stderr, "ns/process_record_user: %.1f\n", (double)user_ns / (double)calls);
+        }
+        fprintf(stderr, "keymap reads/event: %.2f\n", (double)reads / (double)events);
+    }
+    trace_free(&trace);
+    return 0;
+}
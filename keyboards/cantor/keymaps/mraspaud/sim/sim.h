@@ -0,0 +1,138 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Simulator control interface. The QMK stand-in in qmk/ runs on a virtual
+// clock; drivers (the trace replayer, benchmarks) feed it matrix events and
+// advance time through this API.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "quantum.h"
+
+#define SIM_NO_DEADLINE UINT64_MAX
+
+/* Virtual clock, in microseconds since boot. */
+uint64_t sim_time_us(void);
+void     sim_set_time_us(uint64_t t);
+
+/* Earliest pending timeout of the tap-hold, combo, tap dance, Caps Word and
+ * deferred execution machinery, or SIM_NO_DEADLINE. */
+uint64_t sim_next_deadline_us(void);
+
+/* One iteration of the keyboard task at the current time. */
+void sim_task(void);
+
+/* Advances the clock to `t`, running the keyboard task at every deadline on
+ * the way. With a scan rate set, the task also runs once per scan period. */
+void sim_run_until(uint64_t t);
+void sim_set_scan_rate(uint32_t hz);
+
+/* Feeds a matrix transition at the current time. */
+void sim_key_event(uint8_t row, uint8_t col, bool pressed);
+
+/* Boots the keyboard: resets all state and calls the init hooks. */
+void sim_init(void);
+
+/* Host side of the USB link. Every report that reaches the host is passed to
+ * the sink; reports are spaced by at least one polling interval. */
+typedef enum {
+    SIM_REPORT_KEYBOARD,
+    SIM_REPORT_SYSTEM,
+    SIM_REPORT_CONSUMER,
+    SIM_REPORT_BOOTLOADER,
+    SIM_REPORT_REBOOT,
+} sim_report_type_t;
+
+typedef struct {
+    sim_report_type_t type;
+    uint64_t          time_us;
+    report_keyboard_t keyboard;
+    uint16_t          usage;
+} sim_report_t;
+
+typedef void (*sim_report_sink_t)(const sim_report_t *report, void *arg);
+void sim_set_report_sink(sim_report_sink_t sink, void *arg);
+void sim_set_usb_interval_us(uint32_t interval);
+void sim_report_emit(const sim_report_t *report);
+
+/* Layout index (0-41, in LAYOUT_split_3x6_3 argument order) to matrix
+ * position and back. Returns false for an unused position. */
+bool    sim_layout_to_matrix(uint8_t index, uint8_t *row, uint8_t *col);
+uint8_t sim_matrix_to_layout(uint8_t row, uint8_t col);
+#define SIM_LAYOUT_KEYS 42
+
+/* Layer number of one of keymap.c's layers by its name without the L_
+ * ("en", "numsym"), or -1. */
+int sim_layer_named(const char *name);
+
+/* Console output from dprintf/uprintf goes here when set. */
+void sim_set_console(FILE *console);
+
+/* Decodes a stream of keyboard reports into the text a Linux host with a US
+ * (EurKEY) layout would type, including Ctrl+Shift+U Unicode input. */
+typedef struct {
+    report_keyboard_t last;
+    int               unicode_state;
+    uint32_t          unicode_value;
+} sim_text_decoder_t;
+void sim_text_decode(sim_text_decoder_t *decoder, const sim_report_t *report, FILE *out);
+
+/* Per-stage counters for handler cost measurements. */
+typedef struct {
+    uint64_t events;
+    uint64_t user_calls;
+    uint64_t user_ns;
+    uint64_t keymap_reads;   // Reads of the keymap in flash.
+    uint64_t eeprom_writes;  // User datablock updates that changed it.
+} sim_stats_t;
+extern sim_stats_t sim_stats;
+extern bool        sim_stats_enabled;
+uint64_t           sim_wall_ns(void);
+
+/* Tap-hold tuning. Terms given for a keycode replace the keymap's: the
+ * tapping term always, the flow tap term wherever QMK's default
+ * get_flow_tap_term() would apply one. The observer hears every tap-hold
+ * press as it settles. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t tapping_term;
+    uint16_t flow_tap_term;
+} sim_tap_hold_terms_t;
+void sim_set_tap_hold_terms(const sim_tap_hold_terms_t *terms, uint8_t count);
+
+typedef void (*sim_tap_hold_observer_t)(const keyrecord_t *record, uint16_t keycode, bool tap, void *arg);
+void sim_set_tap_hold_observer(sim_tap_hold_observer_t observer, void *arg);
+
+/* Hook points of the simulated internals that the keymap features reach via
+ * the community module mechanism on the board. */
+bool process_record_modules(uint16_t keycode, keyrecord_t *record);
+
+/* Internals shared by the qmk/ translation units. */
+bool     pre_process_record_quantum(keyrecord_t *record);
+void     sim_action_reset(void);
+uint64_t sim_action_deadline_us(void);
+void     sim_action_task(void);
+bool     process_combo(uint16_t keycode, keyrecord_t *record);
+void     combo_task(void);
+void     sim_combo_reset(void);
+uint64_t sim_combo_deadline_us(void);
+bool     preprocess_tap_dance(uint16_t keycode, keyrecord_t *record);
+bool     process_tap_dance(uint16_t keycode, keyrecord_t *record);
+void     tap_dance_task(void);
+void     sim_tap_dance_reset(void);
+uint64_t sim_tap_dance_deadline_us(void);
+bool     process_caps_word(uint16_t keycode, keyrecord_t *record);
+void     caps_word_task(void);
+void     sim_caps_word_reset(void);
+uint64_t sim_caps_word_deadline_us(void);
+bool     process_unicode_common(uint16_t keycode, keyrecord_t *record);
+void     sim_unicode_reset(void);
+void     deferred_exec_task(void);
+void     sim_deferred_exec_reset(void);
+uint64_t sim_deferred_exec_deadline_us(void);
+void     sim_report_reset(void);
+void     sim_eeconfig_reset(void);
+void     sim_activity_trigger(void);
@@ -0,0 +1,132 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+#include "trace.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+static bool trace_push(trace_t *trace, trace_event_t event) {
+    if (trace->count == trace->capacity) {
+        size_t         capacity = trace->capacity ? trace->capacity * 2 : 256;
+        trace_event_t *events   = realloc(trace->events, capacity * sizeof(*events));
+        if (events == NULL) {
+            return false;
+        }
+        trace->events   = events;
+        trace->capacity = capacity;
+    }
+    trace->events[trace->count++] = event;
+    return true;
+}
+
+// Takes a trailing "tap" or "hold" off the line.
+static trace_intent_t take_intent(char *line) {
+    static const struct {
+        const char    *word;
+        trace_intent_t intent;
+    } words[] = {{"tap", TRACE_INTENT_TAP}, {"hold", TRACE_INTENT_HOLD}};
+    for (size_t i = 0; i < ARRAY_SIZE(words); i++) {
+        char *found = strstr(line, words[i].word);
+        if (found != NULL) {
+            *found = '\0';
+            return words[i].intent;
+        }
+    }
+    return TRACE_INTENT_NONE;
+}
+
+bool trace_load(trace_t *trace, FILE *in, const char *name) {
+    char     line[256];
+    unsigned lineno = 0;
+    while (fgets(line, sizeof(line), in) != NULL) {
+        lineno++;
+        char *comment = strchr(line, '#');
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+        const trace_intent_t intent = take_intent(line);
+        unsigned             time_ms, a, b;
+        char                 action;
+        int                  fields = sscanf(line, "%u %c %u %u", &time_ms, &action, &a, &b);
+        if (fields <= 0) {
+            continue;
+        }
+        trace_event_t event = {.time_ms = time_ms, .pressed = action == 'd', .intent = intent};
+        if (fields < 3 || (action != 'd' && action != 'u')) {
+            fprintf(stderr, "%s:%u: expected '<time_ms> d|u <index>' or '<time_ms> d|u <row> <col>'\n", name, lineno);
+            return false;
+        }
+        if (fields == 4) {
+            event.row = a;
+            event.col = b;
+            if (a >= MATRIX_ROWS || b >= MATRIX_COLS) {
+                fprintf(stderr, "%s:%u: matrix position %u,%u out of range\n", name, lineno, a, b);
+                return false;
+            }
+        } else if (a >= SIM_LAYOUT_KEYS || !sim_layout_to_matrix(a, &event.row, &event.col)) {
+            fprintf(stderr, "%s:%u: layout index %u out of range\n", name, lineno, a);
+            return false;
+        }
+        if (trace->count > 0 && time_ms < trace->events[trace->count - 1].time_ms) {
+            fprintf(stderr, "%s:%u: time goes backwards\n", name, lineno);
+            return false;
+        }
+        if (!trace_push(trace, event)) {
+            fprintf(stderr, "%s: out of memory\n", name);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool trace_load_files(trace_t *trace, char **paths, int count) {
+    if (count == 0) {
+        return trace_load(trace, stdin, "<stdin>");
+    }
+    for (int i = 0; i < count; i++) {
+        FILE *in = strcmp(paths[i], "-") == 0 ? stdin : fopen(paths[i], "r");
+        if (in == NULL) {
+            fprintf(stderr, "%s: %s\n", paths[i], strerror(errno));
+            return false;
+        }
+        bool ok = trace_load(trace, in, paths[i]);
+        if (in != stdin) {
+            fclose(in);
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void trace_free(trace_t *trace) {
+    free(trace->events);
+    *trace = (trace_t){0};
+}
+
+uint64_t trace_start(void) {
+    const uint64_t base_us = (sim_time_us() / 1000 + 1000) * 1000;
+    sim_set_time_us(base_us);
+    sim_init();
+    return base_us;
+}
+
+// Time allowed after the last event for pending timeouts to play out.
+#define SETTLE_MS 10000
+
+void trace_replay(const trace_t *trace, uint64_t base_us, trace_event_hook_t hook, void *arg) {
+    for (size_t i = 0; i < trace->count; i++) {
+        const trace_event_t *event = &trace->events[i];
+        sim_run_until(base_us + (uint64_t)event->time_ms * 1000);
+        if (hook != NULL) {
+            hook(event, arg);
+        }
+        sim_key_event(event->row, event->col, event->pressed);
+    }
+    const uint64_t end = sim_time_us() + (uint64_t)SETTLE_MS * 1000;
+    while (sim_next_deadline_us() <= end && sim_time_us() < end) {
+        sim_run_until(sim_next_deadline_us());
+    }
+}
@@ -0,0 +1,57 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Key traces: loading and replaying them through the simulator.
+//
+// A trace has one event per line, `#` starting a comment:
+//
+//     <time_ms> d|u <layout_index> [tap|hold]
+//     <time_ms> d|u <row> <col> [tap|hold]
+//
+// where the layout index (0-41) counts keys in LAYOUT_split_3x6_3 argument
+// order, e.g. 0 is the top-left key and 36-41 are the thumbs. A press of a
+// tap-hold key may say what was meant, for the tap-hold tuner.
+
+#pragma once
+
+#include "sim.h"
+
+typedef enum {
+    TRACE_INTENT_NONE,
+    TRACE_INTENT_TAP,
+    TRACE_INTENT_HOLD,
+} trace_intent_t;
+
+typedef struct {
+    uint32_t       time_ms;
+    uint8_t        row;
+    uint8_t        col;
+    bool           pressed;
+    trace_intent_t intent;
+} trace_event_t;
+
+typedef struct {
+    trace_event_t *events;
+    size_t         count;
+    size_t         capacity;
+} trace_t;
+
+// Appends the events read from `in` to `trace`. Errors are reported on
+// stderr against `name`.
+bool trace_load(trace_t *trace, FILE *in, const char *name);
+
+// Loads every file of `paths` (stdin for "-" or when there are none).
+bool trace_load_files(trace_t *trace, char **paths, int count);
+
+void trace_free(trace_t *trace);
+
+// Boots the keyboard on a fresh millisecond, clear of the previous replay,
+// and returns that time: the trace's time 0.
+uint64_t trace_start(void);
+
+// Called just before each event is fed to the keyboard.
+typedef void (*trace_event_hook_t)(const trace_event_t *event, void *arg);
+
+// Feeds the events at their times from `base_us`, then lets the pending
+// timeouts play out.
+void trace_replay(const trace_t *trace, uint64_t base_us, trace_event_hook_t hook, void *arg);
@@ -0,0 +1,456 @@
+// Copyright 2026 Martin Raspaud (@mraspaud)
+// SPDX-License-Identifier: GPL-2.0
+
+// Tap-hold tuner: replays typing sessions through keymap.c under a grid of
+// tapping and flow tap terms, and picks per-key terms.
+//
+// Session presses of tap-hold keys are labelled with what was meant (see
+// trace.h); a misfire is a labelled press that settles the other way. The
+// latency of a press is how long it took to settle, which is how long its
+// output was held back. Every base layer tap-hold key gets the same terms
+// in a given run, and is scored on its own presses, so one sweep gives the
+// curve of every key.
+//
+// Runs are spread over one forked worker per core. For each key, the
+// configurations that are not beaten on both misfire rate and latency form
+// the Pareto front; the tuner picks the fastest point of the front within
+// --tolerance of the lowest misfire rate, then replays all keys with their
+// picked terms together to check the result against the keymap's own.
+//
+//     ./tune sessions/*.trace
+//     ./tune -T 150:300:5 -F 0:200:10 -o terms.h sessions/*.trace
+
+#include <getopt.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "sim.h"
+#include "trace.h"
+
+#define MAX_KEYS 16
+#define MAX_CONFIGS 4096
+
+typedef struct {
+    uint32_t labelled;
+    uint32_t misfires;
+    uint32_t settled;
+    uint64_t latency_us;
+} key_stats_t;
+
+typedef struct {
+    uint32_t    config;
+    key_stats_t keys[MAX_KEYS];
+} result_t;
+
+typedef struct {
+    uint16_t tapping_term;
+    uint16_t flow_tap_term;
+} config_t;
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint16_t step;
+} range_t;
+
+static uint16_t keycodes[MAX_KEYS];
+static uint8_t  key_count = 0;
+
+/* Replay */
+
+typedef struct {
+    uint64_t       pressed_us[MATRIX_ROWS][MATRIX_COLS];
+    trace_intent_t intent[MATRIX_ROWS][MATRIX_COLS];
+    key_stats_t   *keys;
+} run_t;
+
+static int key_index(uint16_t keycode) {
+    for (uint8_t i = 0; i < key_count; i++) {
+        if (keycodes[i] == keycode) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void on_event(const trace_event_t *event, void *arg) {
+    run_t *run = arg;
+    if (event->pressed) {
+        run->pressed_us[event->row][event->col] = sim_time_us();
+        run->intent[event->row][event->col]     = event->intent;
+    }
+}
+
+static void on_settled(const keyrecord_t *record, uint16_t keycode, bool tap, void *arg) {
+    run_t    *run   = arg;
+    const int index = key_index(keycode);
+    if (index < 0) {
+        return;
+    }
+    const keypos_t       key    = record->event.key;
+    const trace_intent_t intent = run->intent[key.row][key.col];
+    key_stats_t         *stats  = &run->keys[index];
+    stats->settled++;
+    stats->latency_us += sim_time_us() - run->pressed_us[key.row][key.col];
+    if (intent != TRACE_INTENT_NONE) {
+        stats->labelled++;
+        if (tap != (intent == TRACE_INTENT_TAP)) {
+            stats->misfires++;
+        }
+    }
+}
+
+// Replays the sessions with the given terms; other keys keep the keymap's.
+static void evaluate(const trace_t *trace, const sim_tap_hold_terms_t *terms, uint8_t count, key_stats_t *keys) {
+    run_t run = {.keys = keys};
+    memset(keys, 0, sizeof(key_stats_t) * MAX_KEYS);
+    sim_set_tap_hold_terms(terms, count);
+    sim_set_tap_hold_observer(on_settled, &run);
+    trace_replay(trace, trace_start(), on_event, &run);
+    sim_set_tap_hold_observer(NULL, NULL);
+    sim_set_tap_hold_terms(NULL, 0);
+}
+
+static void evaluate_config(const trace_t *trace, config_t config, key_stats_t *keys) {
+    sim_tap_hold_terms_t terms[MAX_KEYS];
+    for (uint8_t i = 0; i < key_count; i++) {
+        terms[i] = (sim_tap_hold_terms_t){keycodes[i], config.tapping_term, config.flow_tap_term};
+    }
+    evaluate(trace, terms, key_count, keys);
+}
+
+static bool write_all(int fd, const void *data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written <= 0) {
+            return false;
+        }
+        data = (const char *)data + written;
+        size -= written;
+    }
+    return true;
+}
+
+static bool read_all(int fd, void *data, size_t size) {
+    while (size > 0) {
+        ssize_t got = read(fd, data, size);
+        if (got <= 0) {
+            return false;
+        }
+        data = (char *)data + got;
+        size -= got;
+    }
+    return true;
+}
+
+// Runs every configuration, worker w taking configurations w, w + workers...
+static bool sweep(const trace_t *trace, const config_t *configs, uint32_t count, unsigned workers, result_t *results) {
+    int   fds[workers];
+    pid_t pids[workers];
+    for (unsigned w = 0; w < workers; w++) {
+        int pipe_fds[2];
+        if (pipe(pipe_fds) != 0) {
+            perror("pipe");
+            return false;
+        }
+        pids[w] = fork();
+        if (pids[w] < 0) {
+            perror("fork");
+            return false;
+        }
+        if (pids[w] == 0) {
+            close(pipe_fds[0]);
+            for (uint32_t i = w; i < count; i += workers) {
+                result_t result = {.config = i};
+                evaluate_config(trace, configs[i], result.keys);
+                if (!write_all(pipe_fds[1], &result, sizeof(result))) {
+                    _exit(1);
+                }
+            }
+            _exit(0);
+        }
+        close(pipe_fds[1]);
+        fds[w] = pipe_fds[0];
+    }
+    bool ok = true;
+    for (unsigned w = 0; w < workers; w++) {
+        result_t result;
+        for (uint32_t i = w; i < count; i += workers) {
+            if (!read_all(fds[w], &result, sizeof(result)) || result.config != i) {
+                ok = false;
+                break;
+            }
+            results[i] = result;
+        }
+        close(fds[w]);
+        int status;
+        waitpid(pids[w], &status, 0);
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    return ok;
+}
+
+/* Choice */
+
+static double misfire_rate(const key_stats_t *stats) {
+    return stats->labelled ? (double)stats->misfires / stats->labelled : 0;
+}
+
+static double mean_latency_ms(const key_stats_t *stats) {
+    return stats->settled ? (double)stats->latency_us / stats->settled / 1000 : 0;
+}
+
+static bool dominates(const key_stats_t *a, const key_stats_t *b) {
+    const double ma = misfire_rate(a), mb = misfire_rate(b);
+    const double la = mean_latency_ms(a), lb = mean_latency_ms(b);
+    return ma <= mb && la <= lb && (ma < mb || la < lb);
+}
+
+static bool on_front(const result_t *results, uint32_t count, uint8_t key, uint32_t i) {
+    for (uint32_t j = 0; j < count; j++) {
+        if (dominates(&results[j].keys[key], &results[i].keys[key])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Fastest front point within `tolerance` of the lowest misfire rate.
+static uint32_t pick(const result_t *results, uint32_t count, uint8_t key, double tolerance, uint32_t *front_size) {
+    double best_rate = 1;
+    for (uint32_t i = 0; i < count; i++) {
+        if (misfire_rate(&results[i].keys[key]) < best_rate) {
+            best_rate = misfire_rate(&results[i].keys[key]);
+        }
+    }
+    uint32_t picked = count;
+    *front_size     = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!on_front(results, count, key, i)) {
+            continue;
+        }
+        (*front_size)++;
+        const key_stats_t *stats = &results[i].keys[key];
+        if (misfire_rate(stats) > best_rate + tolerance) {
+            continue;
+        }
+        if (picked == count || mean_latency_ms(stats) < mean_latency_ms(&results[picked].keys[key])) {
+            picked = i;
+        }
+    }
+    return picked;
+}
+
+/* Output */
+
+static void format_basic(char *out, size_t size, uint8_t keycode) {
+    if (keycode >= KC_A && keycode <= KC_Z) {
+        snprintf(out, size, "KC_%c", 'A' + keycode - KC_A);
+    } else if (keycode >= KC_1 && keycode <= KC_0) {
+        snprintf(out, size, "KC_%c", keycode == KC_0 ? '0' : '1' + keycode - KC_1);
+    } else if (keycode == KC_SPC) {
+        snprintf(out, size, "KC_SPC");
+    } else if (keycode == KC_ESC) {
+        snprintf(out, size, "KC_ESC");
+    } else {
+        snprintf(out, size, "0x%02X", keycode);
+    }
+}
+
+// The keycode as keymap C: MT(MOD_LSFT, KC_N), LT(5, KC_R).
+static void format_keycode(char *out, size_t size, uint16_t keycode) {
+    char tap[16];
+    if (IS_QK_LAYER_TAP(keycode)) {
+        format_basic(tap, sizeof(tap), QK_LAYER_TAP_GET_TAP_KEYCODE(keycode));
+        snprintf(out, size, "LT(%u, %s)", QK_LAYER_TAP_GET_LAYER(keycode), tap);
+        return;
+    }
+    static const char *const names[] = {"CTL", "SFT", "ALT", "GUI"};
+    const uint8_t            mods    = QK_MOD_TAP_GET_MODS(keycode);
+    char                     mod_names[48] = "";
+    for (uint8_t bit = 0; bit < 4; bit++) {
+        if (mods & (1 << bit)) {
+            snprintf(mod_names + strlen(mod_names), sizeof(mod_names) - strlen(mod_names), "%sMOD_%c%s", mod_names[0] ? " | " : "", mods & 0x10 ? 'R' : 'L', names[bit]);
+        }
+    }
+    format_basic(tap, sizeof(tap), QK_MOD_TAP_GET_TAP_KEYCODE(keycode));
+    snprintf(out, size, "MT(%s, %s)", mod_names, tap);
+}
+
+static void print_stats(const char *label, const key_stats_t *stats) {
+    printf("  %-22s misfires %3u/%-4u (%5.1f%%)  latency %6.1f ms\n", label, stats->misfires, stats->labelled, 100 * misfire_rate(stats), mean_latency_ms(stats));
+}
+
+/* Setup */
+
+static bool is_tap_hold(uint16_t keycode) {
+    return IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode);
+}
+
+// The tap-hold keys of the base layer.
+static void find_keys(void) {
+    for (uint8_t index = 0; index < SIM_LAYOUT_KEYS; index++) {
+        uint8_t row, col;
+        if (!sim_layout_to_matrix(index, &row, &col)) {
+            continue;
+        }
+        const uint16_t keycode = keycode_at_keymap_location(0, row, col);
+        if (is_tap_hold(keycode) && key_index(keycode) < 0 && key_count < MAX_KEYS) {
+            keycodes[key_count++] = keycode;
+        }
+    }
+}
+
+static bool parse_range(const char *text, range_t *range) {
+    unsigned min, max, step;
+    if (sscanf(text, "%u:%u:%u", &min, &max, &step) != 3 || step == 0 || min > max || max > UINT16_MAX) {
+        fprintf(stderr, "expected min:max:step, got '%s'\n", text);
+        return false;
+    }
+    *range = (range_t){min, max, step};
+    return true;
+}
+
+static void usage(FILE *out) {
+    fprintf(out,
+            "usage: tune [options] [session ...]\n"
+            "Sweeps tap-hold terms over labelled sessions (stdin when none is given).\n"
+            "  -T, --tapping-terms MIN:MAX:STEP   tapping terms to try (default 150:300:10)\n"
+            "  -F, --flow-tap-terms MIN:MAX:STEP  flow tap terms to try (default 0:200:10)\n"
+            "  -t, --tolerance PCT   misfire rate above the best a pick may have (default 1)\n"
+            "  -j, --jobs N          worker processes (default: one per core)\n"
+            "  -o, --output FILE     write the picked terms as a C header\n");
+}
+
+int main(int argc, char **argv) {
+    static const struct option options[] = {
+        {"tapping-terms", required_argument, NULL, 'T'},
+        {"flow-tap-terms", required_argument, NULL, 'F'},
+        {"tolerance", required_argument, NULL, 't'},
+        {"jobs", required_argument, NULL, 'j'},
+        {"output", required_argument, NULL, 'o'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    range_t     tapping   = {150, 300, 10};
+    range_t     flow      = {0, 200, 10};
+    double      tolerance = 0.01;
+    long        jobs      = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *output    = NULL;
+    int         opt;
+    while ((opt = getopt_long(argc, argv, "T:F:t:j:o:h", options, NULL)) != -1) {
+        switch (opt) {
+            case 'T':
+                if (!parse_range(optarg, &tapping)) {
+                    return 2;
+                }
+                break;
+            case 'F':
+                if (!parse_range(optarg, &flow)) {
+                    return 2;
+                }
+                break;
+            case 't':
+                tolerance = strtod(optarg, NULL) / 100;
+                break;
+            case 'j':
+                jobs = strtol(optarg, NULL, 10);
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+    if (jobs < 1) {
+        jobs = 1;
+    }
+
+    trace_t trace = {0};
+    if (!trace_load_files(&trace, &argv[optind], argc - optind)) {
+        return 1;
+    }
+    find_keys();
+
+    static config_t configs[MAX_CONFIGS];
+    uint32_t        count = 0;
+    for (uint32_t t = tapping.min; t <= tapping.max; t += tapping.step) {
+        for (uint32_t f = flow.min; f <= flow.max && count < MAX_CONFIGS; f += flow.step) {
+            configs[count++] = (config_t){t, f};
+        }
+    }
+    result_t *results = calloc(count, sizeof(*results));
+    if (results == NULL || !sweep(&trace, configs, count, jobs, results)) {
+        fprintf(stderr, "sweep failed\n");
+        return 1;
+    }
+    printf("%u configurations x %zu events, %ld workers\n\n", count, trace.count, jobs);
+
+    key_stats_t baseline[MAX_KEYS];
+    evaluate(&trace, NULL, 0, baseline);
+
+    sim_tap_hold_terms_t picked[MAX_KEYS];
+    uint8_t              picked_count = 0;
+    for (uint8_t key = 0; key < key_count; key++) {
+        char name[48];
+        format_keycode(name, sizeof(name), keycodes[key]);
+        printf("%s\n", name);
+        print_stats("keymap", &baseline[key]);
+        if (baseline[key].labelled == 0) {
+            printf("  no labelled presses, keeping the keymap's terms\n\n");
+            continue;
+        }
+        uint32_t       front_size;
+        const uint32_t i = pick(results, count, key, tolerance, &front_size);
+        picked[picked_count++] = (sim_tap_hold_terms_t){keycodes[key], configs[i].tapping_term, configs[i].flow_tap_term};
+        char label[32];
+        snprintf(label, sizeof(label), "tuned %u/%u", configs[i].tapping_term, configs[i].flow_tap_term);
+        print_stats(label, &results[i].keys[key]);
+        printf("  Pareto front: %u of %u configurations\n\n", front_size, count);
+    }
+
+    key_stats_t combined[MAX_KEYS];
+    evaluate(&trace, picked, picked_count, combined);
+    key_stats_t before = {0}, after = {0};
+    for (uint8_t key = 0; key < key_count; key++) {
+        before.labelled += baseline[key].labelled;
+        before.misfires += baseline[key].misfires;
+        before.settled += baseline[key].settled;
+        before.latency_us += baseline[key].latency_us;
+        after.labelled += combined[key].labelled;
+        after.misfires += combined[key].misfires;
+        after.settled += combined[key].settled;
+        after.latency_us += combined[key].latency_us;
+    }
+    printf("all keys\n");
+    print_stats("keymap", &before);
+    print_stats("tuned, together", &after);
+
+    if (output != NULL) {
+        FILE *out = fopen(output, "w");
+        if (out == NULL) {
+            perror(output);
+            return 1;
+        }
+        fprintf(out, "// Tap-hold terms picked by sim/tune: X(keycode, tapping_term, flow_tap_term).\n");
+        fprintf(out, "// Needs TAPPING_TERM_PER_KEY for the tapping terms.\n\n");
+        fprintf(out, "#pragma once\n\n");
+        fprintf(out, "#define TUNED_TAP_HOLD_TERMS(X)");
+        for (uint8_t i = 0; i < picked_count; i++) {
+            char name[48];
+            format_keycode(name, sizeof(name), picked[i].keycode);
+            fprintf(out, " \\\n    X(%s, %u, %u)", name, picked[i].tapping_term, picked[i].flow_tap_term);
+        }
+        fprintf(out, "\n");
+        fclose(out);
+    }
+    free(results);
+    trace_free(&trace);
+    return 0;
+}
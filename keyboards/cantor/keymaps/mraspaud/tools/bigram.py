@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# Copyright 2026 Martin Raspaud (@mraspaud)
+# SPDX-License-Identifier: GPL-2.0
+
+"""Reads the bigram counts of features/bigram.c.
+
+Over raw HID (Linux hidraw), from a keyboard built with BIGRAM_ENABLE=yes:
+
+    tools/bigram.py             most frequent bigrams and layer changes
+    tools/bigram.py --top 50    more of them
+    tools/bigram.py --save      also have the keyboard write them to EEPROM
+    tools/bigram.py --reset     print them, then clear them on the keyboard
+
+Keys are labelled with the base layer of thornium.yaml when PyYAML is
+installed, and by their LAYOUT index otherwise. Counts are estimates from a
+count-min sketch: never below the true count, sometimes above it.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+from latency import REPORT_SIZE, find_raw_hid
+
+RAW_ID = ord("B")
+INFO, READ, SAVE, RESET = range(4)
+VERSION = 1
+# As in features/bigram.c.
+MULTIPLIERS = [0x9E3779B1, 0x85EBCA77, 0xC2B2AE3D, 0x27D4EB2F]
+LAYER_CHANGE = 63
+KEYS = 42
+# The layer enum of keymap.c.
+LAYERS = ["BASE", "EN", "TH", "SE", "FR", "NUMSYM", "NAV", "FRSYM", "FN"]
+YAML = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "thornium.yaml")
+
+
+def item(layer, prev, cur):
+    return layer << 12 | prev << 6 | cur
+
+
+class Sketch:
+    def __init__(self, rows, total, layers):
+        self.rows = rows
+        self.total = total
+        self.layers = layers
+        # Rows are indexed by the top log2(width) bits of the hash.
+        self.shift = 32 - (len(rows[0]).bit_length() - 1)
+
+    def estimate(self, key):
+        return min(row[(key * multiplier & 0xFFFFFFFF) >> self.shift] for row, multiplier in zip(self.rows, MULTIPLIERS))
+
+    def counted_layers(self):
+        return [layer for layer in range(len(LAYERS)) if self.layers >> layer & 1]
+
+
+class RawHid:
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDWR)
+
+    def request(self, *payload):
+        data = bytes([RAW_ID, *payload]).ljust(REPORT_SIZE, b"\0")
+        # Report ID 0, then the report.
+        os.write(self.fd, b"\0" + data)
+        reply = os.read(self.fd, REPORT_SIZE)
+        if reply[0] != RAW_ID or reply[1] == 0xFF:
+            raise RuntimeError(f"request {list(payload)} refused")
+        return reply
+
+    def read(self):
+        reply = self.request(INFO)
+        rows, width, version = reply[2], 1 << reply[3], reply[4]
+        if version != VERSION:
+            raise RuntimeError(f"sketch version {version}, this tool reads version {VERSION}")
+        total, layers = struct.unpack_from("<2I", reply, 8)
+        counters = []
+        for row in range(rows):
+            values = []
+            while len(values) < width:
+                reply = self.request(READ, row, len(values))
+                chunk = min(width - len(values), (REPORT_SIZE - 4) // 2)
+                values.extend(struct.unpack_from(f"<{chunk}H", reply, 4))
+            counters.append(values)
+        return Sketch(counters, total, layers)
+
+
+def key_labels(path):
+    """Labels of the base layer keys in LAYOUT order, or their indices."""
+    labels = [str(index) for index in range(KEYS)]
+    try:
+        import yaml
+
+        with open(path) as f:
+            base = next(iter(yaml.safe_load(f)["layers"].values()))
+    except (ImportError, OSError, KeyError, StopIteration):
+        return labels
+    keys = []
+
+    def flatten(entries):
+        for entry in entries:
+            if isinstance(entry, list):
+                flatten(entry)
+            else:
+                label = str(entry.get("t", "?") if isinstance(entry, dict) else entry)
+                # $$mdi:keyboard-space$$ -> space
+                keys.append(label.strip("$").split("-")[-1] if label.startswith("$$") else label)
+
+    flatten(base)
+    return keys[:KEYS] + labels[len(keys) :]
+
+
+def print_sketch(sketch, labels, top, out=sys.stdout):
+    print(f"{sketch.total} bigrams and layer changes counted", file=out)
+    for layer in sketch.counted_layers():
+        bigrams = [(sketch.estimate(item(layer, prev, cur)), prev, cur) for prev in range(KEYS) for cur in range(KEYS)]
+        bigrams = sorted((b for b in bigrams if b[0]), reverse=True)
+        layer_total = sum(count for count, _, _ in bigrams)
+        print(f"\n{LAYERS[layer]}: ~{layer_total} bigrams", file=out)
+        for count, prev, cur in bigrams[:top]:
+            share = 100 * count / layer_total
+            print(f"  {labels[prev]:>4} {labels[cur]:<4} {count:>7} {share:5.1f}%", file=out)
+        changes = [(sketch.estimate(item(layer, LAYER_CHANGE, source)), source) for source in range(len(LAYERS)) if source != layer]
+        for count, source in sorted(changes, reverse=True):
+            if count:
+                print(f"  from {LAYERS[source]:<7} {count:>7}", file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--device", help="hidraw node (default: the first raw HID interface)")
+    parser.add_argument("--top", type=int, default=20, help="bigrams printed per layer (default: 20)")
+    parser.add_argument("--yaml", default=YAML, help="keymap-drawer file with the key labels")
+    parser.add_argument("--save", action="store_true", help="have the keyboard write the counts to EEPROM")
+    parser.add_argument("--reset", action="store_true", help="clear the counts after reading them")
+    args = parser.parse_args()
+
+    device = args.device or find_raw_hid()
+    if device is None:
+        print("no raw HID interface found; is the keyboard built with BIGRAM_ENABLE=yes?", file=sys.stderr)
+        return 1
+    hid = RawHid(device)
+    print_sketch(hid.read(), key_labels(args.yaml), args.top)
+    if args.save:
+        hid.request(SAVE)
+    if args.reset:
+        hid.request(RESET)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+# Copyright 2026 Martin Raspaud (@mraspaud)
+# SPDX-License-Identifier: GPL-2.0
+
+"""Reads the latency histograms of features/latency.c.
+
+Over raw HID (Linux hidraw, no extra modules), from a keyboard built with
+LATENCY_ENABLE=yes:
+
+    tools/latency.py            print the histograms
+    tools/latency.py --reset    print them, then clear them on the keyboard
+
+or from the console dump, read on stdin:
+
+    qmk console | tools/latency.py --console
+    sim/sim -c trace 2>&1 >/dev/null | tools/latency.py --console
+
+The console mode prints the last dump it has read once stdin closes, and
+every dump as it comes with --follow.
+"""
+
+import argparse
+import glob
+import os
+import struct
+import sys
+
+RAW_ID = ord("L")
+INFO, SUMMARY, BUCKETS, RESET = range(4)
+REPORT_SIZE = 32
+RAW_USAGE_PAGE = bytes([0x06, 0x60, 0xFF])
+STAGES = ["queue", "tap", "hold", "user", "report"]
+
+
+class Histogram:
+    def __init__(self, name, count, max_us, total_us, buckets):
+        self.name = name
+        self.count = count
+        self.max_us = max_us
+        self.total_us = total_us
+        self.buckets = buckets
+
+    def percentile(self, fraction):
+        """Upper bound of the bucket holding the given fraction of events."""
+        seen = 0
+        for bucket, count in enumerate(self.buckets):
+            seen += count
+            if count and seen >= fraction * self.count:
+                return min(bucket_limit(bucket), self.max_us)
+        return self.max_us
+
+
+def bucket_limit(bucket):
+    return 0 if bucket == 0 else (1 << bucket) - 1
+
+
+def format_us(us):
+    return f"{us / 1000:.1f}ms" if us >= 1000 else f"{us}us"
+
+
+def print_histograms(histograms, out=sys.stdout):
+    for histogram in histograms:
+        mean = histogram.total_us // histogram.count if histogram.count else 0
+        print(
+            f"{histogram.name}: {histogram.count} events, mean {format_us(mean)}, "
+            f"p50 <= {format_us(histogram.percentile(0.5))}, p90 <= {format_us(histogram.percentile(0.9))}, "
+            f"p99 <= {format_us(histogram.percentile(0.99))}, max {format_us(histogram.max_us)}",
+            file=out,
+        )
+        if not histogram.count:
+            continue
+        widest = max(histogram.buckets)
+        for bucket, count in enumerate(histogram.buckets):
+            if not count:
+                continue
+            low = 0 if bucket == 0 else 1 << (bucket - 1)
+            label = "0" if bucket == 0 else f">= {format_us(low)}"
+            bar = "#" * max(1, round(40 * count / widest))
+            print(f"  {label:>11} {count:>7} {bar}", file=out)
+        print(file=out)
+
+
+def find_raw_hid():
+    """Returns the hidraw node of the first raw HID interface found."""
+    for node in sorted(glob.glob("/sys/class/hidraw/hidraw*")):
+        try:
+            with open(os.path.join(node, "device", "report_descriptor"), "rb") as descriptor:
+                if descriptor.read(3) == RAW_USAGE_PAGE:
+                    return "/dev/" + os.path.basename(node)
+        except OSError:
+            continue
+    return None
+
+
+class RawHid:
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDWR)
+
+    def request(self, *payload):
+        data = bytes([RAW_ID, *payload]).ljust(REPORT_SIZE, b"\0")
+        # Report ID 0, then the report.
+        os.write(self.fd, b"\0" + data)
+        reply = os.read(self.fd, REPORT_SIZE)
+        if reply[0] != RAW_ID or reply[1] == 0xFF:
+            raise RuntimeError(f"request {list(payload)} refused")
+        return reply
+
+    def read(self):
+        reply = self.request(INFO)
+        stages, buckets = reply[2], reply[3]
+        histograms = []
+        for stage in range(stages):
+            reply = self.request(SUMMARY, stage)
+            count, max_us, total_low, total_high = struct.unpack_from("<4I", reply, 4)
+            counts = []
+            while len(counts) < buckets:
+                reply = self.request(BUCKETS, stage, len(counts))
+                chunk = min(buckets - len(counts), (REPORT_SIZE - 4) // 4)
+                counts.extend(struct.unpack_from(f"<{chunk}I", reply, 4))
+            name = STAGES[stage] if stage < len(STAGES) else str(stage)
+            histograms.append(Histogram(name, count, max_us, total_low | total_high << 32, counts))
+        return histograms
+
+
+def parse_console(lines, follow):
+    """Collects "latency <stage> <count> <max> <total> <buckets...>" lines."""
+    histograms = {}
+    for line in lines:
+        fields = line.split()
+        if "latency" not in fields:
+            continue
+        fields = fields[fields.index("latency") + 1 :]
+        if len(fields) < 5:
+            continue
+        name, values = fields[0], [int(field) for field in fields[1:]]
+        histograms[name] = Histogram(name, values[0], values[1], values[2], values[3:])
+        if follow and name == STAGES[-1]:
+            print_histograms(histograms.values())
+    return list(histograms.values())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--console", action="store_true", help="parse the console dump on stdin")
+    parser.add_argument("--follow", action="store_true", help="with --console, print every dump")
+    parser.add_argument("--device", help="hidraw node (default: the first raw HID interface)")
+    parser.add_argument("--reset", action="store_true", help="clear the histograms after reading them")
+    args = parser.parse_args()
+
+    if args.console:
+        histograms = parse_console(sys.stdin, args.follow)
+        if not args.follow:
+            print_histograms(histograms)
+        return 0
+
+    device = args.device or find_raw_hid()
+    if device is None:
+        print("no raw HID interface found; is the keyboard built with LATENCY_ENABLE=yes?", file=sys.stderr)
+        return 1
+    hid = RawHid(device)
+    print_histograms(hid.read())
+    if args.reset:
+        hid.request(RESET)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,355 @@
+#!/usr/bin/env python3
+# Copyright 2026 Martin Raspaud (@mraspaud)
+# SPDX-License-Identifier: GPL-2.0
+
+"""Flash and RAM attribution for the linked firmware.
+
+Reads the symbols of the ELF (with nm) and the linker map file, and charges
+every symbol to the first of:
+
+- one of the keymap's own tables (keymaps, tap_dance_actions, ...),
+- one of the keymap's feature files (SRC += features/x.c in rules.mk),
+- one of the QMK features enabled in rules.mk,
+
+or to "other" (QMK core, ChibiOS, libc). With LTO the map file no longer
+says which object a function came from, so global symbols are matched
+through the map's cross reference table (QMK links with --cref), and the
+rest by name.
+
+Flash is text, read-only data and the initial values of data; RAM is data
+and bss. Totals come from the map's output sections, so they include what
+no symbol accounts for (vectors, alignment, the stacks).
+
+Writes the report as JSON and exits with status 1 when a budget is
+exceeded, or set on a feature that is not enabled. A budget file looks like
+
+    {
+        "flash": 98304,
+        "ram": 49152,
+        "symbols": {"keymaps": {"flash": 1024}},
+        "features": {"TAP_DANCE": {"flash": 2048, "ram": 128}}
+    }
+
+where every entry is optional.
+"""
+
+import argparse
+import bisect
+import json
+import os
+import re
+import subprocess
+import sys
+
+# Tables defined in keymap.c. Names that no longer exist are reported as
+# absent rather than dropped, so a budget on them keeps meaning something.
+USERSPACE_SYMBOLS = [
+    "keymaps",
+    "chordal_hold_layout",
+    "chordal_hold_matrix",
+    "tap_dance_actions",
+    "pos_combos",
+    "pos_combo_positions",
+    "unicode_sequences",
+    "expansions",
+    "custom_shift_keys",
+    "unicode_map",
+    "key_combos",
+]
+
+# rules.mk switch, QMK source files, symbol names.
+QMK_FEATURES = [
+    ("COMBO", r"process_combo", r"^(process_combo|combo_|key_combos|is_combo_enabled|get_combo)"),
+    ("TAP_DANCE", r"process_tap_dance", r"tap_dance"),
+    ("UNICODEMAP", r"process_unicodemap|unicode|utf8", r"unicodemap|unicode_map|unicode|utf8|register_hex|send_hex"),
+    ("CAPS_WORD", r"caps_word", r"caps_word"),
+    ("LAYER_LOCK", r"layer_lock", r"layer_lock"),
+    ("REPEAT_KEY", r"repeat_key", r"repeat_key|get_last_(keycode|mods|record)|set_last_"),
+    ("DEFERRED_EXEC", r"deferred_exec", r"defer"),
+    ("BOOTMAGIC", r"bootmagic", r"bootmagic"),
+]
+
+SECTION_RE = re.compile(r"^ (\.\S+|COMMON)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+))?\s*$")
+ADDRESS_RE = re.compile(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+)\s*$")
+OUTPUT_RE = re.compile(r"^(\.\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)(?:\s+load address 0x([0-9a-f]+))?")
+REGION_RE = re.compile(r"^(\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)(?:\s+(\S+))?\s*$")
+
+
+def parse_rules(path):
+    """Returns the enabled switches and the feature files of rules.mk."""
+    enabled = set()
+    sources = []
+    with open(path) as rules:
+        for line in rules:
+            line = line.split("#")[0].strip()
+            match = re.match(r"^(\w+)\s*[:?]?=\s*yes$", line)
+            if match:
+                switch = match.group(1)
+                if switch.endswith("_ENABLE"):
+                    enabled.add(switch[: -len("_ENABLE")])
+            match = re.match(r"^SRC\s*\+=\s*(.+)$", line)
+            if match:
+                sources.extend(match.group(1).split())
+    return enabled, sources
+
+
+def read_symbols(nm, elf):
+    """Returns (name, address, size, kind) for every sized symbol."""
+    output = subprocess.run([nm, "--print-size", elf], check=True, capture_output=True, text=True).stdout
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) != 4:
+            continue
+        address, size, kind, name = fields
+        symbols.append((name, int(address, 16), int(size, 16), kind))
+    return symbols
+
+
+def read_map(path):
+    """Returns the memory regions, output sections, input sections and the
+    defining object of every global symbol in the cross reference table."""
+    regions = []
+    outputs = []
+    inputs = []
+    definitions = {}
+    part = None
+    pending = None
+    with open(path) as mapfile:
+        for line in mapfile:
+            line = line.rstrip("\n")
+            if line.startswith("Memory Configuration"):
+                part = "memory"
+                continue
+            if line.startswith("Linker script and memory map"):
+                part = "map"
+                continue
+            if line.startswith("Cross Reference Table"):
+                part = "cref"
+                continue
+            if part == "memory":
+                match = REGION_RE.match(line)
+                if match and match.group(1) not in ("Name", "*default*"):
+                    regions.append((match.group(1), int(match.group(2), 16), int(match.group(3), 16), match.group(4) or ""))
+            elif part == "map":
+                match = OUTPUT_RE.match(line)
+                if match:
+                    load = int(match.group(4), 16) if match.group(4) else None
+                    outputs.append((match.group(1), int(match.group(2), 16), int(match.group(3), 16), load))
+                    continue
+                match = SECTION_RE.match(line)
+                if match:
+                    pending = None
+                    if match.group(2) is not None:
+                        inputs.append((int(match.group(2), 16), int(match.group(3), 16), match.group(4)))
+                    else:
+                        pending = match.group(1)
+                    continue
+                match = ADDRESS_RE.match(line)
+                if match and pending is not None:
+                    inputs.append((int(match.group(1), 16), int(match.group(2), 16), match.group(3)))
+                pending = None
+            elif part == "cref":
+                # The first file listed under a symbol defines it; long names
+                # push it to the next line.
+                fields = line.split()
+                if line and not line[0].isspace() and fields[0] != "Symbol":
+                    pending = fields[0]
+                    if len(fields) == 2:
+                        definitions[pending] = fields[1]
+                        pending = None
+                elif len(fields) == 1 and pending is not None:
+                    definitions[pending] = fields[0]
+                    pending = None
+                else:
+                    pending = None
+    inputs.sort()
+    return regions, outputs, inputs, definitions
+
+
+def is_flash(address, regions):
+    for name, origin, length, attributes in regions:
+        if origin <= address < origin + length:
+            return "w" not in attributes
+    return False
+
+
+def memory_of(kind, address, regions):
+    """Returns the bytes of a symbol counted in (flash, ram)."""
+    kind = kind.lower()
+    if kind in "tr":
+        return True, False
+    if kind == "d":
+        return True, True
+    if kind == "b":
+        return False, True
+    # Unknown kind: go by address when the map has regions.
+    flash = is_flash(address, regions) if regions else True
+    return flash, not flash
+
+
+def object_of(name, address, inputs, definitions):
+    base = name.split(".")[0]
+    if base in definitions:
+        return definitions[base]
+    index = bisect.bisect_right(inputs, (address, float("inf"), "")) - 1
+    if index >= 0:
+        start, size, path = inputs[index]
+        if start <= address < start + size:
+            return path
+    return ""
+
+
+def feature_buckets(enabled, sources):
+    """Returns (bucket, path pattern, name pattern), in matching order."""
+    buckets = []
+    for source in sources:
+        stem = os.path.splitext(source)[0]
+        prefix = os.path.basename(stem)
+        # custom_shift_keys -> custom_shift_key, timeouts -> timeout...
+        prefix = prefix[:-1] if prefix.endswith("s") else prefix
+        buckets.append((stem, re.compile(re.escape(stem) + r"\.o"), re.compile("^" + re.escape(prefix))))
+    for switch, path, name in QMK_FEATURES:
+        if switch in enabled:
+            buckets.append((switch, re.compile(path), re.compile(name)))
+    return buckets
+
+
+def attribute(symbols, buckets, regions, inputs, definitions):
+    userspace = {name: {"flash": 0, "ram": 0, "present": False} for name in USERSPACE_SYMBOLS}
+    features = {bucket: {"flash": 0, "ram": 0, "symbols": 0} for bucket, _, _ in buckets}
+    other = {"flash": 0, "ram": 0, "symbols": 0}
+    for name, address, size, kind in symbols:
+        flash, ram = memory_of(kind, address, regions)
+        base = name.split(".")[0]
+        if base in userspace:
+            entry = userspace[base]
+            entry["present"] = True
+        else:
+            entry = other
+            path = object_of(name, address, inputs, definitions)
+            for bucket, path_re, name_re in buckets:
+                if (path and path_re.search(path)) or name_re.search(base):
+                    entry = features[bucket]
+                    break
+            entry["symbols"] += 1
+        entry["flash"] += size if flash else 0
+        entry["ram"] += size if ram else 0
+    return userspace, features, other
+
+
+def totals(outputs, regions, symbols):
+    """Returns the flash and RAM used, from the output sections when the map
+    has them."""
+    if not outputs or not regions:
+        flash = ram = 0
+        for name, address, size, kind in symbols:
+            in_flash, in_ram = memory_of(kind, address, regions)
+            flash += size if in_flash else 0
+            ram += size if in_ram else 0
+        return flash, ram
+    flash = ram = 0
+    for name, address, size, load in outputs:
+        if size == 0 or name.startswith(".debug") or name in (".comment", ".ARM.attributes"):
+            continue
+        if is_flash(address, regions):
+            flash += size
+        else:
+            ram += size
+            if load is not None and load != address and is_flash(load, regions):
+                flash += size
+    return flash, ram
+
+
+def check_budget(report, budget):
+    """Returns the budgets exceeded, and those on features the report does
+    not have (not enabled, or misnamed), which would otherwise pass as 0."""
+    exceeded = []
+    absent = []
+
+    def check(what, used, limits):
+        for memory in ("flash", "ram"):
+            if memory in limits and used[memory] > limits[memory]:
+                exceeded.append({"item": what, "memory": memory, "used": used[memory], "budget": limits[memory]})
+
+    check("total", report["total"], budget)
+    for name, limits in budget.get("symbols", {}).items():
+        check(name, report["userspace"].get(name, {"flash": 0, "ram": 0}), limits)
+    for name, limits in budget.get("features", {}).items():
+        if name not in report["features"]:
+            absent.append(name)
+            continue
+        check(name, report["features"][name], limits)
+    return exceeded, absent
+
+
+def print_report(report, out):
+    def row(name, entry):
+        print(f"  {name:<28} {entry['flash']:>8} {entry['ram']:>8}", file=out)
+
+    print(f"  {'':<28} {'flash':>8} {'ram':>8}", file=out)
+    row("total", report["total"])
+    print("keymap tables:", file=out)
+    for name, entry in report["userspace"].items():
+        if entry["present"]:
+            row(name, entry)
+    print("features:", file=out)
+    for name, entry in sorted(report["features"].items(), key=lambda item: -item[1]["flash"]):
+        row(name, entry)
+    row("other", report["other"])
+    for item in report["exceeded"]:
+        print(f"over budget: {item['item']} {item['memory']} {item['used']} > {item['budget']}", file=out)
+    for name in report["absent"]:
+        print(f"budgeted feature not in the firmware: {name}", file=out)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    keymap = os.path.dirname(here)
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf")
+    parser.add_argument("--map", help="linker map file (default: next to the ELF)")
+    parser.add_argument("--rules", default=os.path.join(keymap, "rules.mk"))
+    parser.add_argument("--budget", default=os.path.join(keymap, "size_budget.json"))
+    parser.add_argument("--nm", default=os.environ.get("NM", "arm-none-eabi-nm"))
+    parser.add_argument("-o", "--output", help="JSON report (default: next to the ELF)")
+    args = parser.parse_args()
+
+    stem = os.path.splitext(args.elf)[0]
+    map_path = args.map or stem + ".map"
+    output = args.output or stem + ".size.json"
+
+    enabled, sources = parse_rules(args.rules)
+    symbols = read_symbols(args.nm, args.elf)
+    if os.path.exists(map_path):
+        regions, outputs, inputs, definitions = read_map(map_path)
+    else:
+        print(f"{map_path} not found, attributing by name only", file=sys.stderr)
+        regions, outputs, inputs, definitions = [], [], [], {}
+
+    userspace, features, other = attribute(symbols, feature_buckets(enabled, sources), regions, inputs, definitions)
+    flash, ram = totals(outputs, regions, symbols)
+    report = {
+        "elf": args.elf,
+        "total": {"flash": flash, "ram": ram},
+        "regions": [{"name": name, "origin": origin, "length": length} for name, origin, length, _ in regions],
+        "userspace": userspace,
+        "features": features,
+        "other": other,
+    }
+    budget = {}
+    if os.path.exists(args.budget):
+        with open(args.budget) as budget_file:
+            budget = json.load(budget_file)
+    report["exceeded"], report["absent"] = check_budget(report, budget)
+
+    with open(output, "w") as report_file:
+        json.dump(report, report_file, indent=4)
+        report_file.write("\n")
+    print_report(report, sys.stdout)
+    print(f"report written to {output}")
+    return 1 if report["exceeded"] or report["absent"] else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())